@@ -0,0 +1,200 @@
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <string>
+#include <stdexcept>
+#include <algorithm>
+
+#include "assessment/event/event_processor.h"
+#include "assessment/hardware/gpio_simulator.h"
+#include "assessment/memory/memory_pool.h"
+#include "assessment/realtime/realtime_profile.h"
+#include "queue/lockbased_queue_factory.h"
+#include "loadtest/latency_histogram.h"
+
+// Periodically raises a GPIO interrupt and measures how late the simulation thread delivers it
+// and how late the EventProcessor handler sees the resulting event, once with the default
+// execution profile and once with the real-time profile.
+
+namespace {
+
+using assessment::event::Event;
+using assessment::event::EventProcessor;
+using assessment::event::EventType;
+using assessment::event::Priority;
+using assessment::hardware::GPIOSimulator;
+using assessment::loadtest::LatencyHistogram;
+using assessment::realtime::RealtimeProfile;
+using assessment::realtime::SchedulingPolicy;
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kPin = 0;
+
+struct JitterResult {
+    LatencyHistogram delivery;
+    LatencyHistogram endToEnd;
+    std::string processorReport;
+    std::string simulatorReport;
+};
+
+uint64_t nanosSince(int64_t triggerNs) {
+    const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        Clock::now().time_since_epoch()).count();
+    return static_cast<uint64_t>(std::max<int64_t>(now - triggerNs, 0));
+}
+
+JitterResult runProfile(
+    const RealtimeProfile& processorProfile,
+    const RealtimeProfile& simulatorProfile,
+    size_t iterations,
+    std::chrono::microseconds period) {
+    JitterResult result;
+
+    std::shared_ptr<assessment::queue::ThreadSafeQueue<Event>> eventQueue =
+        assessment::queue::LockBasedQueueFactory::create<Event>();
+    auto memoryPool = std::make_shared<assessment::memory::MemoryPool>(64 * 1024);
+    EventProcessor processor(eventQueue, memoryPool);
+    GPIOSimulator simulator(eventQueue);
+
+    // Only one interrupt is in flight at a time, so a single trigger timestamp is enough
+    std::atomic<int64_t> triggerNs{0};
+    std::atomic<size_t> handled{0};
+    simulator.registerInterruptHandler(kPin, [&](size_t, bool) {
+        result.delivery.record(nanosSince(triggerNs.load(std::memory_order_acquire)));
+    });
+    processor.registerHandler(EventType::HARDWARE_INTERRUPT, [&](const Event&) {
+        result.endToEnd.record(nanosSince(triggerNs.load(std::memory_order_acquire)));
+        handled.fetch_add(1, std::memory_order_release);
+    });
+
+    processor.setRealtimeProfile(processorProfile);
+    simulator.setRealtimeProfile(simulatorProfile);
+    processor.start();
+    simulator.start();
+    result.processorReport = processor.getRealtimeReport().summary();
+    result.simulatorReport = simulator.getRealtimeReport().summary();
+
+    auto next = Clock::now() + period;
+    for (size_t i = 0; i < iterations; ++i) {
+        std::this_thread::sleep_until(next);
+        next += period;
+
+        triggerNs.store(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Clock::now().time_since_epoch()).count(), std::memory_order_release);
+        simulator.simulateInterrupt(kPin);
+
+        // Wait for this interrupt to come out the other end before raising the next one
+        const auto giveUp = Clock::now() + std::chrono::milliseconds(100);
+        while (handled.load(std::memory_order_acquire) <= i && Clock::now() < giveUp) {
+            std::this_thread::yield();
+        }
+    }
+
+    simulator.stop();
+    processor.stop();
+    return result;
+}
+
+void printHistogram(const char* label, const LatencyHistogram& histogram) {
+    auto us = [](uint64_t nanos) { return static_cast<double>(nanos) / 1000.0; };
+    std::cout << "  " << std::left << std::setw(14) << label << std::right << std::fixed << std::setprecision(1)
+              << "p50 " << std::setw(8) << us(histogram.percentile(50.0))
+              << "  p99 " << std::setw(8) << us(histogram.percentile(99.0))
+              << "  p99.9 " << std::setw(8) << us(histogram.percentile(99.9))
+              << "  max " << std::setw(9) << us(histogram.max()) << " us"
+              << "  (" << histogram.count() << " samples)\n";
+}
+
+void printResult(const char* name, const JitterResult& result) {
+    std::cout << name << "\n";
+    std::cout << "  processor:    " << result.processorReport << "\n";
+    std::cout << "  simulator:    " << result.simulatorReport << "\n";
+    printHistogram("delivery", result.delivery);
+    printHistogram("end-to-end", result.endToEnd);
+}
+
+size_t parseCount(const std::string& name, const char* value, size_t minimum = 1) {
+    try {
+        size_t used = 0;
+        const unsigned long long parsed = std::stoull(value, &used);
+        if (value[used] == '\0' && parsed >= minimum) {
+            return static_cast<size_t>(parsed);
+        }
+    } catch (const std::exception&) {
+    }
+    throw std::invalid_argument("invalid value for " + name + ": '" + value + "'");
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t iterations = 5000;
+    std::chrono::microseconds period{1000};
+    int processorCpu = -1;
+    int simulatorCpu = -1;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("missing value for " + arg);
+            }
+            if (arg == "--iterations") {
+                iterations = parseCount(arg, argv[++i]);
+            } else if (arg == "--period-us") {
+                period = std::chrono::microseconds(parseCount(arg, argv[++i]));
+            } else if (arg == "--processor-cpu") {
+                processorCpu = static_cast<int>(parseCount(arg, argv[++i], 0));
+            } else if (arg == "--simulator-cpu") {
+                simulatorCpu = static_cast<int>(parseCount(arg, argv[++i], 0));
+            } else {
+                throw std::invalid_argument("unknown option " + arg);
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR: " << e.what() << "\n"
+                  << "Usage: " << argv[0]
+                  << " [--iterations N] [--period-us US] [--processor-cpu CPU] [--simulator-cpu CPU]"
+                  << std::endl;
+        return 1;
+    }
+
+    // Without explicit CPUs, pin the two threads to the last two CPUs, away from CPU 0 where
+    // most housekeeping lands
+    const int cpus = static_cast<int>(std::thread::hardware_concurrency());
+    if (processorCpu < 0 && cpus >= 3) {
+        processorCpu = cpus - 1;
+    }
+    if (simulatorCpu < 0 && cpus >= 3) {
+        simulatorCpu = cpus - 2;
+    }
+
+    RealtimeProfile processorProfile;
+    processorProfile.policy = SchedulingPolicy::FIFO;
+    processorProfile.priority = Priority::HIGH;
+    processorProfile.cpu = processorCpu;
+    processorProfile.lockMemory = true;
+    processorProfile.stackPrefaultBytes = 256 * 1024;
+
+    // Interrupt delivery outranks event processing, as on real hardware
+    RealtimeProfile simulatorProfile = processorProfile;
+    simulatorProfile.priority = Priority::CRITICAL;
+    simulatorProfile.cpu = simulatorCpu;
+
+    std::cout << "GPIO interrupt jitter: " << iterations << " interrupts every "
+              << period.count() << " us\n" << std::endl;
+
+    try {
+        printResult("Default profile", runProfile(RealtimeProfile{}, RealtimeProfile{}, iterations, period));
+        std::cout << std::endl;
+        printResult("Real-time profile", runProfile(processorProfile, simulatorProfile, iterations, period));
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -42,6 +42,20 @@ public:
      */
     Event(uint64_t id, EventType type, Priority priority, std::string payload);
     
+    /**
+     * @brief Construct an Event with an explicit creation timestamp
+     *
+     * Used when an event is reconstructed from a serialized form, e.g. a shared-memory queue,
+     * so that latency is still measured from the original creation time.
+     * @param id Unique event ID
+     * @param type Event type
+     * @param priority Event priority
+     * @param payload Event payload
+     * @param timestamp Creation timestamp
+     */
+    Event(uint64_t id, EventType type, Priority priority, std::string payload,
+          std::chrono::steady_clock::time_point timestamp);
+    
     /**
      * @brief Destroy the Event object
      */
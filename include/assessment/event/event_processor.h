@@ -5,23 +5,44 @@
 #include <atomic>
 #include <functional>
 #include <unordered_map>
+#include <array>
+#include <vector>
+#include <cstdint>
 
 #include "assessment/event/event.h"
+#include "assessment/event/event_span.h"
 #include "assessment/queue/thread_safe_queue.h"
 #include "assessment/memory/memory_pool.h"
+#include "assessment/realtime/realtime_profile.h"
 
 namespace assessment {
 namespace event {
 
 /**
  * @brief Event processor for handling events in real-time
+ *
+ * With a maximum batch size above 1, the processing thread drains up to that many events
+ * that are already queued (it never waits to fill a batch), checks their deadlines in one
+ * pass, groups them by type and dispatches each group under a single handler lock. Batch
+ * handlers receive a whole group in one call; per-event handlers are called once per event.
+ * Order is preserved within a type but not across types in the same batch.
  */
 class EventProcessor {
 public:
+    /// Handler invoked once per batch with all batched events of one type
+    using BatchHandler = std::function<void(EventSpan)>;
+    
+    /// Default maximum batch size; 1 processes events strictly one at a time in queue order
+    static constexpr size_t DEFAULT_MAX_BATCH_SIZE = 1;
+
+    /// Largest accepted batch size; the processing thread preallocates buffers for a full batch
+    static constexpr size_t MAX_BATCH_SIZE = 4096;
+
     /**
      * @brief Construct a new Event Processor
      * @param eventQueue Event queue
      * @param memoryPool Memory pool for allocations
+     * @throws std::invalid_argument if eventQueue is null
      */
     EventProcessor(
         std::shared_ptr<queue::ThreadSafeQueue<Event>> eventQueue,
@@ -41,6 +62,8 @@ public:
     
     /**
      * @brief Start the event processor
+     *
+     * Applies the real-time profile on the new thread before returning; see getRealtimeReport().
      */
     void start();
     
@@ -49,6 +72,20 @@ public:
      */
     void stop();
     
+    /**
+     * @brief Set the real-time profile applied to the processing thread
+     *
+     * Takes effect at the next start(); has no effect on a thread that is already running.
+     * @param profile Profile to apply
+     */
+    void setRealtimeProfile(const realtime::RealtimeProfile& profile);
+    
+    /**
+     * @brief Get what the last start() applied of the real-time profile
+     * @return Report from the most recent start()
+     */
+    realtime::RealtimeReport getRealtimeReport() const;
+    
     /**
      * @brief Register an event handler
      * @param type Event type
@@ -57,11 +94,34 @@ public:
     void registerHandler(EventType type, std::function<void(const Event&)> handler);
     
     /**
-     * @brief Unregister an event handler
+     * @brief Register a batch handler, replacing any per-event handler for the type
+     * @param type Event type
+     * @param handler Handler receiving all events of the type in the current batch
+     */
+    void registerBatchHandler(EventType type, BatchHandler handler);
+    
+    /**
+     * @brief Unregister the per-event or batch handler of a type
      * @param type Event type
      */
     void unregisterHandler(EventType type);
     
+    /**
+     * @brief Set the maximum number of events processed as one batch
+     *
+     * Bounds the extra latency batching adds: an event waits for at most this many events
+     * ahead of it in the same batch.
+     * @param maxBatchSize Maximum batch size
+     * @throws std::invalid_argument if maxBatchSize is 0 or above MAX_BATCH_SIZE
+     */
+    void setMaxBatchSize(size_t maxBatchSize);
+    
+    /**
+     * @brief Get the maximum batch size
+     * @return Maximum batch size
+     */
+    size_t getMaxBatchSize() const;
+    
     /**
      * @brief Check if event processor is running
      * @return true if running
@@ -87,14 +147,31 @@ private:
     // Process a single event
     void processEvent(const Event& event);
     
+    // Process batch_: deadline check, group by type, dispatch
+    void processBatch();
+    
+    static constexpr size_t EVENT_TYPE_COUNT = 4;
+    static_assert(static_cast<size_t>(EventType::SYSTEM) + 1 == EVENT_TYPE_COUNT,
+                  "batchByType_ needs one bucket per EventType");
+    
     std::shared_ptr<queue::ThreadSafeQueue<Event>> eventQueue_;
     std::shared_ptr<memory::MemoryPool> memoryPool_;
     std::unordered_map<EventType, std::function<void(const Event&)>> handlers_;
+    std::unordered_map<EventType, BatchHandler> batchHandlers_;
+    std::atomic<size_t> maxBatchSize_;
+    
+    // Batch buffers, touched only by the processing thread and reused across batches
+    std::vector<Event> batch_;
+    std::array<std::vector<Event>, EVENT_TYPE_COUNT> batchByType_;
+    std::vector<int64_t> batchDeadlines_;
+    
     std::atomic<bool> running_;
     std::atomic<size_t> processedEventCount_;
     std::atomic<size_t> missedDeadlineCount_;
     std::thread processingThread_;
     std::mutex handlersMutex_;
+    realtime::RealtimeProfile realtimeProfile_;
+    realtime::RealtimeReport realtimeReport_;
 };
 
 } // namespace event
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+
+#include "assessment/event/event.h"
+
+namespace assessment {
+namespace event {
+
+/**
+ * @brief Read-only view over a contiguous run of events
+ *
+ * Plays the role of std::span<const Event> while the project targets C++17. A span handed
+ * to a batch handler is only valid for the duration of the call.
+ */
+class EventSpan {
+public:
+    EventSpan() noexcept : data_(nullptr), size_(0) {}
+    EventSpan(const Event* data, size_t size) noexcept : data_(data), size_(size) {}
+
+    const Event* begin() const noexcept { return data_; }
+    const Event* end() const noexcept { return data_ + size_; }
+    const Event* data() const noexcept { return data_; }
+    size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    const Event& operator[](size_t index) const { return data_[index]; }
+    const Event& front() const { return data_[0]; }
+    const Event& back() const { return data_[size_ - 1]; }
+
+private:
+    const Event* data_;
+    size_t size_;
+};
+
+} // namespace event
+} // namespace assessment
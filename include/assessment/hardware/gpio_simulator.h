@@ -6,9 +6,12 @@
 #include <functional>
 #include <array>
 #include <unordered_map>
+#include <mutex>
+#include <condition_variable>
 
 #include "assessment/event/event.h"
 #include "assessment/queue/thread_safe_queue.h"
+#include "assessment/realtime/realtime_profile.h"
 
 namespace assessment {
 namespace hardware {
@@ -39,6 +42,8 @@ public:
     
     /**
      * @brief Start the simulator
+     *
+     * Applies the real-time profile on the new thread before returning; see getRealtimeReport().
      */
     void start();
     
@@ -47,9 +52,31 @@ public:
      */
     void stop();
     
+    /**
+     * @brief Set the real-time profile applied to the simulation thread
+     *
+     * Takes effect at the next start(); has no effect on a thread that is already running.
+     * @param profile Profile to apply
+     */
+    void setRealtimeProfile(const realtime::RealtimeProfile& profile);
+    
+    /**
+     * @brief Get what the last start() applied of the real-time profile
+     * @return Report from the most recent start()
+     */
+    realtime::RealtimeReport getRealtimeReport() const;
+    
     /**
      * @brief Simulate an interrupt on a pin
+     *
+     * While the simulator is running the interrupt is latched as pending and delivered
+     * by the simulation thread; otherwise it is delivered on the calling thread.
+     * Each pin latches a single pending bit, like an edge-triggered interrupt controller:
+     * interrupts raised on a pin whose previous interrupt has not been delivered yet are
+     * merged into one delivery and one HARDWARE_INTERRUPT event.
+     * Interrupts on a pin with interrupts disabled are ignored.
      * @param pin Pin number
+     * @throws std::out_of_range if pin >= PIN_COUNT
      */
     void simulateInterrupt(size_t pin);
     
@@ -117,14 +144,31 @@ private:
     // Simulation thread
     std::thread simulationThread_;
     
+    // Real-time profile applied to the simulation thread and what start() applied of it
+    realtime::RealtimeProfile realtimeProfile_;
+    realtime::RealtimeReport realtimeReport_;
+    
     // Mutex for handlers
     mutable std::mutex handlersMutex_;
     
     // Event ID counter
     std::atomic<uint64_t> nextEventId_;
     
+    // Pending interrupt bits, one per pin, drained by the simulation thread
+    std::atomic<uint32_t> pendingInterrupts_;
+    
+    // Wakes the simulation thread when an interrupt is latched or on stop
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCondition_;
+    
     // Simulation loop
     void simulationLoop();
+    
+    // Toggle the pin, run its handler and post a HARDWARE_INTERRUPT event
+    void deliverInterrupt(size_t pin);
+    
+    // Throws std::out_of_range for invalid pins
+    static void checkPin(size_t pin);
 };
 
 } // namespace hardware
@@ -1,12 +1,23 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
+#include <array>
+#include <ostream>
 #include <mutex>
 #include <atomic>
 #include <vector>
 #include <memory>
 #include <stdexcept>
 
+#define ASSESSMENT_POOL_STRINGIFY_IMPL(x) #x
+#define ASSESSMENT_POOL_STRINGIFY(x) ASSESSMENT_POOL_STRINGIFY_IMPL(x)
+
+/**
+ * @brief Static "file:line" string naming the current allocation site for MemoryPool::allocate()
+ */
+#define ASSESSMENT_POOL_SITE (__FILE__ ":" ASSESSMENT_POOL_STRINGIFY(__LINE__))
+
 namespace assessment {
 namespace memory {
 
@@ -20,9 +31,40 @@ namespace memory {
  * - Memory usage tracking
  * - Efficient allocation and deallocation
  * - Memory leak detection
+ *
+ * Every live allocation has an entry, indexed by its first block, in a table sized at
+ * construction; it records the allocation's size so deallocate() can reject a size that does
+ * not match. An opt-in profiling mode (enableProfiling()) also records the allocation site and
+ * time in the same entry, so profiled allocations still never touch the heap. It also keeps an
+ * allocation-latency histogram and can report the top holders of pool memory. While profiling
+ * is off the only extra cost is one relaxed load.
  */
 class MemoryPool {
 public:
+    /// Allocation latency bucket i counts allocations that took [2^i, 2^(i+1)) nanoseconds
+    static constexpr size_t LATENCY_BUCKETS = 32;
+
+    /**
+     * @brief Snapshot of free-space fragmentation
+     */
+    struct FragmentationInfo {
+        size_t freeBlocks;       ///< Total free blocks
+        size_t freeRuns;         ///< Number of maximal runs of contiguous free blocks
+        size_t largestFreeRun;   ///< Length of the longest free run, in blocks
+        double index;            ///< 1 - largestFreeRun / freeBlocks; 0 when unfragmented or full
+    };
+
+    /**
+     * @brief Live allocations attributed to one allocation site
+     */
+    struct HolderInfo {
+        const char* site;        ///< Site passed to allocate(), or nullptr
+        const void* caller;      ///< Return address of the allocate() call
+        size_t bytes;            ///< Bytes held, rounded up to whole blocks
+        size_t allocations;      ///< Number of live allocations
+        uint64_t oldestAgeNs;    ///< Age of the oldest live allocation
+    };
+
     /**
      * @brief Construct a new Memory Pool object
      * @param totalSize Total size of the memory pool in bytes
@@ -52,11 +94,21 @@ public:
      */
     void* allocate(size_t size);
     
+    /**
+     * @brief Allocate memory from the pool, naming the allocation site for profiling
+     * @param size Size of memory to allocate in bytes
+     * @param site Static site name, typically ASSESSMENT_POOL_SITE
+     * @return Pointer to allocated memory
+     * @throws std::bad_alloc if pool is full or not enough contiguous blocks
+     */
+    void* allocate(size_t size, const char* site);
+    
     /**
      * @brief Deallocate memory previously allocated from the pool
      * @param ptr Pointer to memory to deallocate
-     * @param size Size of memory to deallocate
-     * @throws std::invalid_argument if ptr is null or not from this pool
+     * @param size Size passed to allocate(); any size needing the same number of blocks matches
+     * @throws std::invalid_argument if ptr is null, not the start of a live allocation from this
+     *         pool, or size does not match that allocation
      */
     void deallocate(void* ptr, size_t size);
     
@@ -90,6 +142,15 @@ public:
      */
     size_t getUsedSize() const;
     
+    /**
+     * @brief Get the high-water mark of used memory since construction
+     *
+     * Updated on every allocation, so it catches short-lived peaks that sampling
+     * getUsedSize() would miss.
+     * @return Peak used size in bytes
+     */
+    size_t getPeakUsedSize() const;
+    
     /**
      * @brief Get the available memory size
      * @return Available size in bytes
@@ -107,6 +168,89 @@ public:
      * @return true if no more allocations can be made
      */
     bool isFull() const;
+    
+    /**
+     * @brief Start profiling allocations
+     *
+     * Clears previous profile data; allocations made before this call are not attributed.
+     * Makes no heap allocation.
+     */
+    void enableProfiling();
+    
+    /**
+     * @brief Stop profiling allocations; collected data stays readable
+     */
+    void disableProfiling();
+    
+    /**
+     * @brief Check if profiling is enabled
+     * @return true if allocations are being profiled
+     */
+    bool isProfiling() const;
+    
+    /**
+     * @brief Measure free-space fragmentation
+     * @return Fragmentation snapshot; available whether or not profiling is enabled
+     */
+    FragmentationInfo getFragmentation() const;
+    
+    /**
+     * @brief Get the allocation latency histogram collected while profiling
+     * @return Counts per LATENCY_BUCKETS power-of-two nanosecond bucket
+     */
+    std::array<uint64_t, LATENCY_BUCKETS> getAllocationLatencyHistogram() const;
+    
+    /**
+     * @brief Get the allocation sites holding the most memory
+     *
+     * Holds the pool lock only while copying live records; aggregation runs without it, so a
+     * dump does not stall allocate() and deallocate() on other threads.
+     * @param count Maximum number of sites to return
+     * @return Sites ordered by bytes held, largest first; empty unless profiling was enabled
+     */
+    std::vector<HolderInfo> getTopHolders(size_t count) const;
+    
+    /**
+     * @brief Write a human-readable profile: usage, fragmentation, latency and top holders
+     *
+     * Also written to std::cerr on destruction if profiling is enabled and blocks are still
+     * allocated.
+     * @param out Output stream
+     * @param topCount Number of top holders to list
+     */
+    void dumpProfile(std::ostream& out, size_t topCount = 10) const;
+
+private:
+    // Allocation-table entry, indexed by the first block of a live allocation. blocks is 0 for
+    // blocks that do not start one; timestampNs is 0 unless the allocation was profiled
+    struct AllocationRecord {
+        const char* site;
+        const void* caller;
+        uint64_t timestampNs;
+        size_t blocks;
+    };
+
+    void* allocateImpl(size_t size, const char* site, const void* caller);
+
+    // Find the first run of `count` free blocks at or after `start`; returns blockCount_ if none
+    size_t findFreeRun(size_t start, size_t count) const;
+
+    // Number of blocks needed to hold `size` bytes
+    size_t blocksFor(size_t size) const;
+
+    size_t blockSize_;
+    size_t blockCount_;
+    std::unique_ptr<unsigned char[]> buffer_;
+    std::vector<bool> blockUsed_;
+    size_t nextFitHint_;
+    std::atomic<size_t> usedBlocks_;
+    std::atomic<size_t> peakUsedBlocks_;
+    std::atomic<size_t> allocationCount_;
+    std::atomic<size_t> deallocationCount_;
+    std::atomic<bool> profiling_;
+    std::vector<AllocationRecord> allocations_;
+    std::array<uint64_t, LATENCY_BUCKETS> allocationLatency_;
+    mutable std::mutex mutex_;
 };
 
 } // namespace memory
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "assessment/event/event.h"
+
+namespace assessment {
+namespace realtime {
+
+/**
+ * @brief OS scheduling policy for a real-time thread
+ */
+enum class SchedulingPolicy {
+    DEFAULT,      // Leave the thread on the normal time-sharing scheduler
+    FIFO,         // SCHED_FIFO
+    ROUND_ROBIN   // SCHED_RR
+};
+
+/**
+ * @brief Execution profile applied to a worker thread when it starts
+ *
+ * A default-constructed profile changes nothing, so components behave exactly as before
+ * unless a profile is set explicitly.
+ */
+struct RealtimeProfile {
+    /// Scheduling policy; DEFAULT leaves the scheduler untouched
+    SchedulingPolicy policy = SchedulingPolicy::DEFAULT;
+
+    /// Event priority the thread serves, mapped onto the policy's native priority range
+    event::Priority priority = event::Priority::HIGH;
+
+    /// CPU to pin the thread to, or -1 to leave affinity untouched
+    int cpu = -1;
+
+    /// Lock current and future process memory with mlockall()
+    bool lockMemory = false;
+
+    /// Bytes of stack to touch up front so page faults do not happen on the hot path; clamped
+    /// to half the thread's stack, or to 64 KiB if the stack size cannot be determined
+    size_t stackPrefaultBytes = 0;
+};
+
+/**
+ * @brief What applyToCurrentThread() managed to apply
+ *
+ * Every requested setting that could not be applied, typically for lack of privileges,
+ * leaves a human-readable entry in `issues` instead of failing the caller.
+ */
+struct RealtimeReport {
+    bool affinityApplied = false;
+    bool schedulingApplied = false;
+    bool memoryLocked = false;
+    size_t stackPrefaulted = 0;
+    std::vector<std::string> issues;
+
+    /**
+     * @brief Get a one-line summary of applied settings and issues
+     * @return Summary text
+     */
+    std::string summary() const;
+};
+
+/**
+ * @brief Map an event priority onto a policy's native priority range
+ * @param policy Scheduling policy
+ * @param priority Event priority
+ * @return Native priority; 0 for SchedulingPolicy::DEFAULT
+ */
+int toNativePriority(SchedulingPolicy policy, event::Priority priority);
+
+/**
+ * @brief Apply a profile to the calling thread
+ *
+ * Never throws for missing privileges or unsupported platforms; those are reported.
+ * @param profile Profile to apply
+ * @return Report of what was applied
+ */
+RealtimeReport applyToCurrentThread(const RealtimeProfile& profile);
+
+} // namespace realtime
+} // namespace assessment
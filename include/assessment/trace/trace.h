@@ -0,0 +1,169 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace assessment {
+namespace trace {
+
+/**
+ * @brief Kind of a trace record, mirroring the Chrome trace-event phases
+ */
+enum class RecordKind : uint8_t {
+    BEGIN,
+    END,
+    INSTANT,
+    COUNTER
+};
+
+/**
+ * @brief Fixed-size binary trace record
+ *
+ * `name` must point to storage that outlives the trace (in practice a string literal);
+ * records are copied verbatim and the name is only dereferenced at export time.
+ */
+struct TraceRecord {
+    uint64_t timestampNs;
+    const char* name;
+    int64_t value;
+    RecordKind kind;
+};
+
+/**
+ * @brief Number of records each thread's ring buffer holds before overwriting the oldest
+ */
+constexpr size_t RECORDS_PER_THREAD = size_t{1} << 16;
+
+namespace detail {
+inline std::atomic<bool> enabled{false};
+} // namespace detail
+
+/**
+ * @brief Check whether tracing is enabled at runtime
+ * @return true if trace points record
+ */
+inline bool isEnabled() {
+    return detail::enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Enable or disable recording at runtime
+ * @param enabled New state
+ */
+void setEnabled(bool enabled);
+
+/**
+ * @brief Append a record to the calling thread's ring buffer
+ *
+ * Every record is a plain store into the calling thread's ring buffer. A thread whose buffer
+ * was not allocated by setThreadName() gets it from its first record instead. Callers normally
+ * go through the ASSESSMENT_TRACE_* macros, which skip this call entirely while tracing is
+ * disabled.
+ * @param kind Record kind
+ * @param name Static event name
+ * @param value Counter value, ignored for other kinds
+ */
+void record(RecordKind kind, const char* name, int64_t value = 0);
+
+/**
+ * @brief Name the calling thread in exported traces and, while tracing is enabled, allocate its
+ * ring buffer
+ *
+ * Call this at thread start, before any latency-sensitive work, so that no trace point on the
+ * thread allocates (the buffer holds RECORDS_PER_THREAD records). While tracing is disabled
+ * only the name is kept; the buffer then comes from the thread's first record.
+ * @param name Static thread name
+ */
+void setThreadName(const char* name);
+
+/**
+ * @brief Drop all recorded events; buffers of exited threads are released
+ *
+ * Buffers of exited threads that recorded nothing are also released whenever a thread
+ * registers, so only exited threads with records wait for this call. Like export, call this
+ * while traced threads are quiescent.
+ */
+void clear();
+
+/**
+ * @brief Write all recorded events as Chrome trace-event JSON
+ *
+ * The output loads in chrome://tracing and in the Perfetto UI. Export while traced threads
+ * are quiescent; records written concurrently with the export may be torn.
+ * @param out Output stream
+ */
+void writeChromeTrace(std::ostream& out);
+
+/**
+ * @brief Write all recorded events as Chrome trace-event JSON to a file
+ * @param path Output file path
+ * @throws std::runtime_error if the file cannot be written
+ */
+void writeChromeTrace(const std::string& path);
+
+/**
+ * @brief RAII begin/end pair; records nothing if tracing was disabled at construction
+ */
+class ScopedTrace {
+public:
+    explicit ScopedTrace(const char* name) : name_(isEnabled() ? name : nullptr) {
+        if (name_) {
+            record(RecordKind::BEGIN, name_);
+        }
+    }
+
+    ~ScopedTrace() {
+        if (name_) {
+            record(RecordKind::END, name_);
+        }
+    }
+
+    ScopedTrace(const ScopedTrace&) = delete;
+    ScopedTrace& operator=(const ScopedTrace&) = delete;
+    ScopedTrace(ScopedTrace&&) = delete;
+    ScopedTrace& operator=(ScopedTrace&&) = delete;
+
+private:
+    const char* name_;
+};
+
+} // namespace trace
+} // namespace assessment
+
+#if defined(__GNUC__) || defined(__clang__)
+#define ASSESSMENT_TRACE_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#else
+#define ASSESSMENT_TRACE_UNLIKELY(x) (x)
+#endif
+
+#define ASSESSMENT_TRACE_CONCAT_IMPL(a, b) a##b
+#define ASSESSMENT_TRACE_CONCAT(a, b) ASSESSMENT_TRACE_CONCAT_IMPL(a, b)
+
+// Trace points compile to nothing unless the build defines ASSESSMENT_ENABLE_TRACING;
+// when compiled in, a disabled trace point costs one well-predicted branch.
+#ifdef ASSESSMENT_ENABLE_TRACING
+#define ASSESSMENT_TRACE_RECORD(kind, name, value)                                   \
+    do {                                                                             \
+        if (ASSESSMENT_TRACE_UNLIKELY(::assessment::trace::isEnabled())) {           \
+            ::assessment::trace::record((kind), (name), (value));                    \
+        }                                                                            \
+    } while (0)
+#define ASSESSMENT_TRACE_SCOPE(name) \
+    ::assessment::trace::ScopedTrace ASSESSMENT_TRACE_CONCAT(assessmentTraceScope_, __LINE__)(name)
+#define ASSESSMENT_TRACE_THREAD_NAME(name) ::assessment::trace::setThreadName(name)
+#else
+#define ASSESSMENT_TRACE_RECORD(kind, name, value) ((void)0)
+#define ASSESSMENT_TRACE_SCOPE(name) ((void)0)
+#define ASSESSMENT_TRACE_THREAD_NAME(name) ((void)0)
+#endif
+
+#define ASSESSMENT_TRACE_BEGIN(name) \
+    ASSESSMENT_TRACE_RECORD(::assessment::trace::RecordKind::BEGIN, name, 0)
+#define ASSESSMENT_TRACE_END(name) \
+    ASSESSMENT_TRACE_RECORD(::assessment::trace::RecordKind::END, name, 0)
+#define ASSESSMENT_TRACE_INSTANT(name) \
+    ASSESSMENT_TRACE_RECORD(::assessment::trace::RecordKind::INSTANT, name, 0)
+#define ASSESSMENT_TRACE_COUNTER(name, value) \
+    ASSESSMENT_TRACE_RECORD(::assessment::trace::RecordKind::COUNTER, name, static_cast<int64_t>(value))
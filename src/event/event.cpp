@@ -0,0 +1,31 @@
+#include "assessment/event/event.h"
+
+namespace assessment {
+namespace event {
+
+Event::Event(uint64_t id, EventType type, Priority priority, std::string payload)
+    : Event(id, type, priority, std::move(payload), std::chrono::steady_clock::now()) {}
+
+Event::Event(uint64_t id, EventType type, Priority priority, std::string payload,
+             std::chrono::steady_clock::time_point timestamp)
+    : id_(id),
+      type_(type),
+      priority_(priority),
+      payload_(std::move(payload)),
+      timestamp_(timestamp),
+      deadline_(std::chrono::steady_clock::time_point::max()) {}
+
+bool operator<(const Event& lhs, const Event& rhs) {
+    // Lower priority sorts first; among equals the older event is "greater" so it is served first
+    if (lhs.getPriority() != rhs.getPriority()) {
+        return lhs.getPriority() < rhs.getPriority();
+    }
+    return lhs.getTimestamp() > rhs.getTimestamp();
+}
+
+bool operator>(const Event& lhs, const Event& rhs) {
+    return rhs < lhs;
+}
+
+} // namespace event
+} // namespace assessment
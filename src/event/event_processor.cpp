@@ -0,0 +1,234 @@
+#include "assessment/event/event_processor.h"
+#include "assessment/trace/trace.h"
+
+#include <future>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace assessment {
+namespace event {
+
+namespace {
+// How long the processing thread blocks on an empty queue before re-checking running_
+constexpr std::chrono::milliseconds kDequeueTimeout{10};
+
+int64_t toNanos(std::chrono::steady_clock::time_point time) {
+    if (time == std::chrono::steady_clock::time_point::max()) {
+        return std::numeric_limits<int64_t>::max();
+    }
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+// Branch-free over a plain array so the compiler can vectorize it wherever the target has
+// 64-bit integer compares (SSE4.2/AVX2, NEON); "no deadline" is stored as INT64_MAX and
+// therefore never counts as missed
+size_t countMissedDeadlines(const int64_t* deadlines, size_t count, int64_t now) {
+    size_t missed = 0;
+    for (size_t i = 0; i < count; ++i) {
+        missed += static_cast<size_t>(deadlines[i] < now);
+    }
+    return missed;
+}
+} // namespace
+
+EventProcessor::EventProcessor(
+    std::shared_ptr<queue::ThreadSafeQueue<Event>> eventQueue,
+    std::shared_ptr<memory::MemoryPool> memoryPool)
+    : eventQueue_(std::move(eventQueue)),
+      memoryPool_(std::move(memoryPool)),
+      maxBatchSize_(DEFAULT_MAX_BATCH_SIZE),
+      running_(false),
+      processedEventCount_(0),
+      missedDeadlineCount_(0) {
+    if (!eventQueue_) {
+        throw std::invalid_argument("EventProcessor: event queue must not be null");
+    }
+}
+
+EventProcessor::~EventProcessor() {
+    stop();
+}
+
+void EventProcessor::start() {
+    if (running_.exchange(true)) {
+        return;
+    }
+    // The profile is applied on the new thread itself; start() returns once it is in effect
+    std::promise<realtime::RealtimeReport> applied;
+    auto report = applied.get_future();
+    processingThread_ = std::thread([this, applied = std::move(applied)]() mutable {
+        // Register the trace buffer before the profile locks memory and raises priority
+        ASSESSMENT_TRACE_THREAD_NAME("EventProcessor");
+        applied.set_value(realtime::applyToCurrentThread(realtimeProfile_));
+        processingLoop();
+    });
+    realtimeReport_ = report.get();
+}
+
+void EventProcessor::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    if (processingThread_.joinable()) {
+        processingThread_.join();
+    }
+}
+
+void EventProcessor::setRealtimeProfile(const realtime::RealtimeProfile& profile) {
+    realtimeProfile_ = profile;
+}
+
+realtime::RealtimeReport EventProcessor::getRealtimeReport() const {
+    return realtimeReport_;
+}
+
+void EventProcessor::registerHandler(EventType type, std::function<void(const Event&)> handler) {
+    std::lock_guard<std::mutex> lock(handlersMutex_);
+    batchHandlers_.erase(type);
+    handlers_[type] = std::move(handler);
+}
+
+void EventProcessor::registerBatchHandler(EventType type, BatchHandler handler) {
+    std::lock_guard<std::mutex> lock(handlersMutex_);
+    handlers_.erase(type);
+    batchHandlers_[type] = std::move(handler);
+}
+
+void EventProcessor::unregisterHandler(EventType type) {
+    std::lock_guard<std::mutex> lock(handlersMutex_);
+    handlers_.erase(type);
+    batchHandlers_.erase(type);
+}
+
+void EventProcessor::setMaxBatchSize(size_t maxBatchSize) {
+    if (maxBatchSize == 0 || maxBatchSize > MAX_BATCH_SIZE) {
+        throw std::invalid_argument(
+            "EventProcessor: maximum batch size must be between 1 and " + std::to_string(MAX_BATCH_SIZE));
+    }
+    maxBatchSize_.store(maxBatchSize);
+}
+
+size_t EventProcessor::getMaxBatchSize() const {
+    return maxBatchSize_.load();
+}
+
+bool EventProcessor::isRunning() const {
+    return running_.load();
+}
+
+size_t EventProcessor::getProcessedEventCount() const {
+    return processedEventCount_.load();
+}
+
+size_t EventProcessor::getMissedDeadlineCount() const {
+    return missedDeadlineCount_.load();
+}
+
+void EventProcessor::processingLoop() {
+    while (running_.load(std::memory_order_relaxed)) {
+        auto event = eventQueue_->waitDequeue(kDequeueTimeout);
+        if (!event) {
+            if (eventQueue_->isShutDown()) {
+                break;
+            }
+            continue;
+        }
+
+        const size_t maxBatchSize = maxBatchSize_.load(std::memory_order_relaxed);
+        if (maxBatchSize == 1) {
+            processEvent(*event);
+            continue;
+        }
+
+        // Only take what is already queued; waiting to fill a batch would add latency
+        batch_.reserve(maxBatchSize);
+        batch_.push_back(std::move(*event));
+        while (batch_.size() < maxBatchSize) {
+            auto next = eventQueue_->waitDequeue(std::chrono::milliseconds(0));
+            if (!next) {
+                break;
+            }
+            batch_.push_back(std::move(*next));
+        }
+        processBatch();
+    }
+}
+
+void EventProcessor::processEvent(const Event& event) {
+    ASSESSMENT_TRACE_SCOPE("EventProcessor::processEvent");
+    if (event.isPastDeadline()) {
+        missedDeadlineCount_.fetch_add(1, std::memory_order_relaxed);
+        ASSESSMENT_TRACE_INSTANT("deadline missed");
+    }
+
+    {
+        // Handlers run under the lock so unregisterHandler() never races a running handler
+        std::lock_guard<std::mutex> lock(handlersMutex_);
+        auto it = handlers_.find(event.getType());
+        if (it != handlers_.end() && it->second) {
+            it->second(event);
+        } else {
+            auto batchIt = batchHandlers_.find(event.getType());
+            if (batchIt != batchHandlers_.end() && batchIt->second) {
+                batchIt->second(EventSpan(&event, 1));
+            }
+        }
+    }
+
+    processedEventCount_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void EventProcessor::processBatch() {
+    ASSESSMENT_TRACE_SCOPE("EventProcessor::processBatch");
+    const size_t count = batch_.size();
+
+    // Deadlines are checked against one clock reading in a single structure-of-arrays pass
+    batchDeadlines_.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        batchDeadlines_[i] = toNanos(batch_[i].getDeadline());
+    }
+    const size_t missed = countMissedDeadlines(
+        batchDeadlines_.data(), count, toNanos(std::chrono::steady_clock::now()));
+    if (missed != 0) {
+        missedDeadlineCount_.fetch_add(missed, std::memory_order_relaxed);
+        ASSESSMENT_TRACE_COUNTER("deadlines missed in batch", missed);
+    }
+
+    for (auto& event : batch_) {
+        // An out-of-range type (e.g. from a corrupt cross-process record) has no handler to run
+        const auto index = static_cast<size_t>(event.getType());
+        if (index < batchByType_.size()) {
+            batchByType_[index].push_back(std::move(event));
+        }
+    }
+    batch_.clear();
+
+    {
+        std::lock_guard<std::mutex> lock(handlersMutex_);
+        for (size_t index = 0; index < batchByType_.size(); ++index) {
+            auto& group = batchByType_[index];
+            if (group.empty()) {
+                continue;
+            }
+            const auto type = static_cast<EventType>(index);
+            auto batchIt = batchHandlers_.find(type);
+            if (batchIt != batchHandlers_.end() && batchIt->second) {
+                batchIt->second(EventSpan(group.data(), group.size()));
+            } else {
+                auto it = handlers_.find(type);
+                if (it != handlers_.end() && it->second) {
+                    for (const auto& event : group) {
+                        it->second(event);
+                    }
+                }
+            }
+            group.clear();
+        }
+    }
+
+    processedEventCount_.fetch_add(count, std::memory_order_relaxed);
+}
+
+} // namespace event
+} // namespace assessment
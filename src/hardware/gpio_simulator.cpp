@@ -0,0 +1,175 @@
+#include "assessment/hardware/gpio_simulator.h"
+#include "assessment/trace/trace.h"
+
+#include <future>
+#include <stdexcept>
+#include <string>
+
+namespace assessment {
+namespace hardware {
+
+static_assert(GPIOSimulator::PIN_COUNT <= 32, "pending interrupt mask holds at most 32 pins");
+
+GPIOSimulator::GPIOSimulator(std::shared_ptr<queue::ThreadSafeQueue<event::Event>> eventQueue)
+    : eventQueue_(std::move(eventQueue)),
+      running_(false),
+      nextEventId_(0),
+      pendingInterrupts_(0) {
+    if (!eventQueue_) {
+        throw std::invalid_argument("GPIOSimulator: event queue must not be null");
+    }
+    for (size_t pin = 0; pin < PIN_COUNT; ++pin) {
+        pins_[pin].store(false);
+        interruptEnabled_[pin].store(true);
+    }
+}
+
+GPIOSimulator::~GPIOSimulator() {
+    stop();
+}
+
+void GPIOSimulator::start() {
+    if (running_.exchange(true)) {
+        return;
+    }
+    std::promise<realtime::RealtimeReport> applied;
+    auto report = applied.get_future();
+    simulationThread_ = std::thread([this, applied = std::move(applied)]() mutable {
+        // Register the trace buffer before the profile locks memory and raises priority
+        ASSESSMENT_TRACE_THREAD_NAME("GPIOSimulator");
+        applied.set_value(realtime::applyToCurrentThread(realtimeProfile_));
+        simulationLoop();
+    });
+    realtimeReport_ = report.get();
+}
+
+void GPIOSimulator::stop() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        if (!running_.exchange(false)) {
+            return;
+        }
+    }
+    wakeCondition_.notify_all();
+    if (simulationThread_.joinable()) {
+        simulationThread_.join();
+    }
+}
+
+void GPIOSimulator::setRealtimeProfile(const realtime::RealtimeProfile& profile) {
+    realtimeProfile_ = profile;
+}
+
+realtime::RealtimeReport GPIOSimulator::getRealtimeReport() const {
+    return realtimeReport_;
+}
+
+void GPIOSimulator::simulateInterrupt(size_t pin) {
+    checkPin(pin);
+    if (!interruptEnabled_[pin].load()) {
+        return;
+    }
+
+    bool latched = false;
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        if (running_.load()) {
+            pendingInterrupts_.fetch_or(1u << pin);
+            latched = true;
+        }
+    }
+    if (latched) {
+        wakeCondition_.notify_one();
+    } else {
+        deliverInterrupt(pin);
+    }
+}
+
+void GPIOSimulator::setPinValue(size_t pin, bool value) {
+    checkPin(pin);
+    pins_[pin].store(value);
+}
+
+bool GPIOSimulator::getPinValue(size_t pin) const {
+    checkPin(pin);
+    return pins_[pin].load();
+}
+
+void GPIOSimulator::registerInterruptHandler(size_t pin, std::function<void(size_t, bool)> handler) {
+    checkPin(pin);
+    std::lock_guard<std::mutex> lock(handlersMutex_);
+    interruptHandlers_[pin] = std::move(handler);
+}
+
+void GPIOSimulator::unregisterInterruptHandler(size_t pin) {
+    checkPin(pin);
+    std::lock_guard<std::mutex> lock(handlersMutex_);
+    interruptHandlers_.erase(pin);
+}
+
+void GPIOSimulator::enableInterrupts(size_t pin) {
+    checkPin(pin);
+    interruptEnabled_[pin].store(true);
+}
+
+void GPIOSimulator::disableInterrupts(size_t pin) {
+    checkPin(pin);
+    interruptEnabled_[pin].store(false);
+    pendingInterrupts_.fetch_and(~(1u << pin));
+}
+
+bool GPIOSimulator::isRunning() const {
+    return running_.load();
+}
+
+void GPIOSimulator::simulationLoop() {
+    while (true) {
+        uint32_t pending = 0;
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex_);
+            wakeCondition_.wait(lock, [this] {
+                return !running_.load() || pendingInterrupts_.load() != 0;
+            });
+            pending = pendingInterrupts_.exchange(0);
+            if (pending == 0 && !running_.load()) {
+                return;
+            }
+        }
+
+        // Lowest pin number is serviced first, like a fixed-priority interrupt controller
+        for (size_t pin = 0; pin < PIN_COUNT; ++pin) {
+            if (pending & (1u << pin)) {
+                deliverInterrupt(pin);
+            }
+        }
+    }
+}
+
+void GPIOSimulator::deliverInterrupt(size_t pin) {
+    ASSESSMENT_TRACE_SCOPE("GPIOSimulator::deliverInterrupt");
+    const bool value = !pins_[pin].load();
+    pins_[pin].store(value);
+
+    {
+        std::lock_guard<std::mutex> lock(handlersMutex_);
+        auto it = interruptHandlers_.find(pin);
+        if (it != interruptHandlers_.end() && it->second) {
+            it->second(pin, value);
+        }
+    }
+
+    eventQueue_->enqueue(event::Event(
+        nextEventId_.fetch_add(1),
+        event::EventType::HARDWARE_INTERRUPT,
+        event::Priority::HIGH,
+        "pin=" + std::to_string(pin) + " value=" + (value ? "1" : "0")));
+}
+
+void GPIOSimulator::checkPin(size_t pin) {
+    if (pin >= PIN_COUNT) {
+        throw std::out_of_range("GPIOSimulator: pin " + std::to_string(pin) + " out of range");
+    }
+}
+
+} // namespace hardware
+} // namespace assessment
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <algorithm>
+
+namespace assessment {
+namespace loadtest {
+
+/**
+ * @brief Fixed-footprint log-linear latency histogram
+ *
+ * Values below 2^SUB_BUCKET_BITS are recorded exactly; above that each power of two is
+ * split into 2^SUB_BUCKET_BITS linear sub-buckets, bounding the relative error of any
+ * reported percentile to roughly 1 / 2^SUB_BUCKET_BITS. Recording never allocates, so a
+ * histogram can live on a real-time thread. Not thread-safe: give each writer its own
+ * histogram and merge() them once the writers have stopped.
+ */
+class LatencyHistogram {
+public:
+    static constexpr unsigned SUB_BUCKET_BITS = 5;
+    static constexpr size_t SUB_BUCKET_COUNT = size_t{1} << SUB_BUCKET_BITS;
+    // One exact group for values below SUB_BUCKET_COUNT, then one group per shift in [0, 64 - SUB_BUCKET_BITS)
+    static constexpr size_t BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+    LatencyHistogram() { reset(); }
+
+    /**
+     * @brief Record a single sample
+     * @param value Sample value (any unit, typically nanoseconds)
+     */
+    void record(uint64_t value) {
+        ++buckets_[bucketIndex(value)];
+        ++count_;
+        sum_ += value;
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+    }
+
+    /**
+     * @brief Add all samples of another histogram into this one
+     * @param other Histogram to merge
+     */
+    void merge(const LatencyHistogram& other) {
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            buckets_[i] += other.buckets_[i];
+        }
+        count_ += other.count_;
+        sum_ += other.sum_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+    }
+
+    /**
+     * @brief Discard all samples
+     */
+    void reset() {
+        buckets_.fill(0);
+        count_ = 0;
+        sum_ = 0;
+        min_ = UINT64_MAX;
+        max_ = 0;
+    }
+
+    /**
+     * @brief Get the value at a percentile
+     * @param percentile Percentile in [0, 100]
+     * @return Upper bound of the bucket holding the percentile, clamped to the recorded max;
+     *         0 if no samples were recorded
+     */
+    uint64_t percentile(double percentile) const {
+        if (count_ == 0) {
+            return 0;
+        }
+        const double clamped = std::min(100.0, std::max(0.0, percentile));
+        uint64_t rank = static_cast<uint64_t>(clamped / 100.0 * static_cast<double>(count_) + 0.5);
+        rank = std::max<uint64_t>(rank, 1);
+
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            seen += buckets_[i];
+            if (seen >= rank) {
+                return std::min(bucketUpperBound(i), max_);
+            }
+        }
+        return max_;
+    }
+
+    uint64_t count() const { return count_; }
+    uint64_t min() const { return count_ == 0 ? 0 : min_; }
+    uint64_t max() const { return max_; }
+    double mean() const { return count_ == 0 ? 0.0 : static_cast<double>(sum_) / static_cast<double>(count_); }
+
+private:
+    static size_t bucketIndex(uint64_t value) {
+        if (value < SUB_BUCKET_COUNT) {
+            return static_cast<size_t>(value);
+        }
+        unsigned msb = 63;
+        while ((value >> msb) == 0) {
+            --msb;
+        }
+        // Keep the SUB_BUCKET_BITS bits below the leading one; value >> shift lies in
+        // [SUB_BUCKET_COUNT, 2 * SUB_BUCKET_COUNT), so every sub-bucket of a group is used
+        const unsigned shift = msb - SUB_BUCKET_BITS;
+        const size_t sub = static_cast<size_t>(value >> shift) - SUB_BUCKET_COUNT;
+        return (shift + 1) * SUB_BUCKET_COUNT + sub;
+    }
+
+    static uint64_t bucketUpperBound(size_t index) {
+        if (index < SUB_BUCKET_COUNT) {
+            return index;
+        }
+        const size_t shift = index / SUB_BUCKET_COUNT - 1;
+        const uint64_t sub = index % SUB_BUCKET_COUNT;
+        // Wraps to UINT64_MAX for the topmost bucket, which is its true upper bound
+        return ((SUB_BUCKET_COUNT + sub + 1) << shift) - 1;
+    }
+
+    std::array<uint64_t, BUCKET_COUNT> buckets_;
+    uint64_t count_;
+    uint64_t sum_;
+    uint64_t min_;
+    uint64_t max_;
+};
+
+} // namespace loadtest
+} // namespace assessment
@@ -1,78 +1,624 @@
 #include <iostream>
+#include <iomanip>
+#include <sstream>
 #include <memory>
 #include <thread>
 #include <chrono>
 #include <vector>
 #include <string>
 #include <functional>
+#include <array>
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <ctime>
+#include <cstring>
+#include <stdexcept>
 
 #include "assessment/queue/thread_safe_queue.h"
 #include "assessment/event/event_processor.h"
 #include "assessment/memory/memory_pool.h"
-#include "assessment/hardware/gpio_simulator.h"
 #include "queue/lockbased_queue_factory.h"
+#include "queue/shared_memory_queue.h"
+#include "assessment/trace/trace.h"
+#include "loadtest/latency_histogram.h"
 
-int main() {
-    std::cout << "Real-time System Simulation" << std::endl;
-    std::cout << "============================" << std::endl;
+namespace {
 
+using assessment::event::Event;
+using assessment::event::EventProcessor;
+using assessment::event::EventType;
+using assessment::event::Priority;
+using assessment::loadtest::LatencyHistogram;
+using assessment::memory::MemoryPool;
+using assessment::queue::ThreadSafeQueue;
+using Clock = std::chrono::steady_clock;
+
+constexpr std::array<EventType, 4> kEventTypes = {
+    EventType::HARDWARE_INTERRUPT, EventType::TIMER, EventType::USER_INPUT, EventType::SYSTEM};
+
+// How long the driver waits for workers to drain the queue once producers stop
+constexpr std::chrono::seconds kDrainTimeout{2};
+
+// How often the driver samples queue depth while a trial runs
+constexpr std::chrono::milliseconds kSampleInterval{10};
+
+// Exponential payload sizes are capped at this multiple of the mean so they have a bound
+constexpr size_t kExponentialPayloadCap = 16;
+
+enum class PayloadDistribution {
+    FIXED,
+    UNIFORM,
+    EXPONENTIAL
+};
+
+struct PayloadSpec {
+    PayloadDistribution distribution = PayloadDistribution::FIXED;
+    size_t first = 64;   // fixed size, uniform minimum or exponential mean
+    size_t second = 64;  // uniform maximum, unused otherwise
+
+    size_t maxSize() const {
+        switch (distribution) {
+        case PayloadDistribution::UNIFORM: return second;
+        case PayloadDistribution::EXPONENTIAL: return first * kExponentialPayloadCap;
+        default: return first;
+        }
+    }
+};
+
+struct LoadTestConfig {
+    std::string queue = "lockbased";
+    size_t shmCapacity = 65536;
+    size_t workers = 1;
+    size_t batchSize = 1;
+    size_t producers = 1;
+    size_t poolSize = 1024 * 1024;
+    size_t blockSize = 64;
+    double rate = 10000.0;
+    PayloadSpec payload;
+    std::array<unsigned, 4> priorityMix = {40, 30, 20, 10};
+    double durationSeconds = 5.0;
+    std::chrono::microseconds deadline{1000};
+    bool search = false;
+    double targetP99Us = 500.0;
+    double searchMinRate = 1000.0;
+    double searchMaxRate = 1000000.0;
+    unsigned searchSteps = 8;
+    std::string tracePath;
+    bool poolProfile = false;
+};
+
+struct TrialResult {
+    double offeredRate = 0.0;
+    uint64_t produced = 0;
+    uint64_t processed = 0;
+    uint64_t missedDeadlines = 0;
+    uint64_t poolFailures = 0;
+    size_t peakPoolUsed = 0;
+    size_t peakQueueDepth = 0;
+    size_t queueCapacity = 0;
+    uint64_t producerStalls = 0;
+    double elapsedSeconds = 0.0;
+    double cpuSeconds = 0.0;
+    bool drained = true;
+    LatencyHistogram latency;
+    std::string poolProfile;
+};
+
+// Per-worker measurements; written only by that worker's processing thread
+struct WorkerStats {
+    LatencyHistogram latency;
+    uint64_t processed = 0;
+    uint64_t poolFailures = 0;
+};
+
+void printUsage(const char* program) {
+    std::cout
+        << "Usage: " << program << " [options]\n"
+        << "\n"
+        << "Options (--name=value or --name value):\n"
+        << "  --queue=NAME            queue implementation: lockbased | shm (default lockbased)\n"
+        << "  --shm-capacity=N        ring capacity in events for --queue=shm (default 65536); once the\n"
+        << "                          ring is full producers block, so size it for rate x worst drain time\n"
+        << "  --workers=N             EventProcessor instances sharing the queue (default 1)\n"
+        << "  --producers=N           producer threads splitting the event rate (default 1)\n"
+        << "  --batch-size=N          max events per worker batch, at most " << EventProcessor::MAX_BATCH_SIZE
+        << "; above 1 uses batch\n"
+        << "                          handlers (default 1)\n"
+        << "  --pool-size=BYTES       MemoryPool capacity (default 1048576)\n"
+        << "  --block-size=BYTES      MemoryPool block size (default 64)\n"
+        << "  --rate=EVENTS_PER_SEC   offered event rate (default 10000)\n"
+        << "  --payload=SPEC          fixed:N | uniform:MIN:MAX | exp:MEAN, capped at 16x MEAN (default fixed:64)\n"
+        << "  --priority-mix=L:M:H:C  relative weights of LOW:MEDIUM:HIGH:CRITICAL (default 40:30:20:10)\n"
+        << "  --duration=SECONDS      length of each trial (default 5)\n"
+        << "  --deadline-us=US        per-event deadline relative to its enqueue time (default 1000)\n"
+        << "  --search                search for the highest rate whose p99 stays within --target-p99-us\n"
+        << "  --target-p99-us=US      p99 latency bound for --search (default 500)\n"
+        << "  --search-min-rate=R     lower bound of the search (default 1000)\n"
+        << "  --search-max-rate=R     upper bound of the search (default 1000000)\n"
+        << "  --search-steps=N        bisection steps (default 8)\n"
+        << "  --trace=PATH            record a Chrome trace-event JSON timeline to PATH\n"
+        << "  --pool-profile          profile MemoryPool allocations and print the profile after each trial\n"
+        << "  --help                  show this message\n";
+}
+
+size_t parseSize(const std::string& name, const std::string& value) {
+    try {
+        size_t used = 0;
+        const unsigned long long parsed = std::stoull(value, &used);
+        if (used == value.size() && value.find('-') == std::string::npos) {
+            return static_cast<size_t>(parsed);
+        }
+    } catch (const std::exception&) {
+    }
+    throw std::invalid_argument("invalid value for --" + name + ": '" + value + "'");
+}
+
+double parseDouble(const std::string& name, const std::string& value) {
+    try {
+        size_t used = 0;
+        const double parsed = std::stod(value, &used);
+        if (used == value.size() && parsed > 0.0) {
+            return parsed;
+        }
+    } catch (const std::exception&) {
+    }
+    throw std::invalid_argument("invalid value for --" + name + ": '" + value + "'");
+}
+
+std::vector<std::string> split(const std::string& value, char separator) {
+    std::vector<std::string> parts;
+    size_t begin = 0;
+    while (true) {
+        const size_t end = value.find(separator, begin);
+        parts.push_back(value.substr(begin, end - begin));
+        if (end == std::string::npos) {
+            return parts;
+        }
+        begin = end + 1;
+    }
+}
+
+PayloadSpec parsePayload(const std::string& value) {
+    const auto parts = split(value, ':');
+    PayloadSpec spec;
+    if (parts.size() == 2 && parts[0] == "fixed") {
+        spec.distribution = PayloadDistribution::FIXED;
+        spec.first = spec.second = parseSize("payload", parts[1]);
+    } else if (parts.size() == 3 && parts[0] == "uniform") {
+        spec.distribution = PayloadDistribution::UNIFORM;
+        spec.first = parseSize("payload", parts[1]);
+        spec.second = parseSize("payload", parts[2]);
+        if (spec.first > spec.second) {
+            throw std::invalid_argument("invalid value for --payload: minimum exceeds maximum");
+        }
+    } else if (parts.size() == 2 && parts[0] == "exp") {
+        spec.distribution = PayloadDistribution::EXPONENTIAL;
+        spec.first = parseSize("payload", parts[1]);
+        if (spec.first == 0) {
+            throw std::invalid_argument("invalid value for --payload: exponential mean must be non-zero");
+        }
+    } else {
+        throw std::invalid_argument("invalid value for --payload: '" + value + "'");
+    }
+    return spec;
+}
+
+std::array<unsigned, 4> parsePriorityMix(const std::string& value) {
+    const auto parts = split(value, ':');
+    if (parts.size() != 4) {
+        throw std::invalid_argument("--priority-mix expects four weights L:M:H:C");
+    }
+    std::array<unsigned, 4> mix{};
+    unsigned total = 0;
+    for (size_t i = 0; i < mix.size(); ++i) {
+        mix[i] = static_cast<unsigned>(parseSize("priority-mix", parts[i]));
+        total += mix[i];
+    }
+    if (total == 0) {
+        throw std::invalid_argument("--priority-mix needs at least one non-zero weight");
+    }
+    return mix;
+}
+
+// Returns false if --help was requested
+bool parseArguments(int argc, char* argv[], LoadTestConfig& config) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            return false;
+        }
+        if (arg.rfind("--", 0) != 0) {
+            throw std::invalid_argument("unexpected argument '" + arg + "'");
+        }
+        arg.erase(0, 2);
+
+        if (arg == "search") {
+            config.search = true;
+            continue;
+        }
+        if (arg == "pool-profile") {
+            config.poolProfile = true;
+            continue;
+        }
+
+        std::string name = arg;
+        std::string value;
+        const size_t equals = arg.find('=');
+        if (equals != std::string::npos) {
+            name = arg.substr(0, equals);
+            value = arg.substr(equals + 1);
+        } else if (i + 1 < argc) {
+            value = argv[++i];
+        } else {
+            throw std::invalid_argument("missing value for --" + name);
+        }
+
+        if (name == "queue") {
+            config.queue = value;
+        } else if (name == "shm-capacity") {
+            config.shmCapacity = parseSize(name, value);
+        } else if (name == "workers") {
+            config.workers = parseSize(name, value);
+        } else if (name == "producers") {
+            config.producers = parseSize(name, value);
+        } else if (name == "batch-size") {
+            config.batchSize = parseSize(name, value);
+        } else if (name == "pool-size") {
+            config.poolSize = parseSize(name, value);
+        } else if (name == "block-size") {
+            config.blockSize = parseSize(name, value);
+        } else if (name == "rate") {
+            config.rate = parseDouble(name, value);
+        } else if (name == "payload") {
+            config.payload = parsePayload(value);
+        } else if (name == "priority-mix") {
+            config.priorityMix = parsePriorityMix(value);
+        } else if (name == "duration") {
+            config.durationSeconds = parseDouble(name, value);
+        } else if (name == "deadline-us") {
+            config.deadline = std::chrono::microseconds(parseSize(name, value));
+        } else if (name == "target-p99-us") {
+            config.targetP99Us = parseDouble(name, value);
+        } else if (name == "search-min-rate") {
+            config.searchMinRate = parseDouble(name, value);
+        } else if (name == "search-max-rate") {
+            config.searchMaxRate = parseDouble(name, value);
+        } else if (name == "search-steps") {
+            config.searchSteps = static_cast<unsigned>(parseSize(name, value));
+        } else if (name == "trace") {
+            config.tracePath = value;
+        } else {
+            throw std::invalid_argument("unknown option --" + name);
+        }
+    }
+
+    if (config.workers == 0 || config.producers == 0 || config.batchSize == 0) {
+        throw std::invalid_argument("--workers, --producers and --batch-size must be at least 1");
+    }
+    if (config.batchSize > EventProcessor::MAX_BATCH_SIZE) {
+        throw std::invalid_argument(
+            "--batch-size must be at most " + std::to_string(EventProcessor::MAX_BATCH_SIZE));
+    }
+    if (config.search && config.searchMinRate >= config.searchMaxRate) {
+        throw std::invalid_argument("--search-min-rate must be below --search-max-rate");
+    }
+    return true;
+}
+
+std::shared_ptr<ThreadSafeQueue<Event>> makeQueue(const LoadTestConfig& config) {
+    if (config.queue == "lockbased") {
+        return assessment::queue::LockBasedQueueFactory::create<Event>();
+    }
+#ifdef __linux__
+    if (config.queue == "shm") {
+        // Same segment layout a separate process would attach to, exercised in-process here
+        return assessment::queue::SharedMemoryQueueFactory::create(
+            config.shmCapacity, std::max<size_t>(config.payload.maxSize(), 1));
+    }
+#endif
+    throw std::invalid_argument("unknown queue implementation '" + config.queue + "'");
+}
+
+// Open-loop producer: events are sent on a fixed schedule regardless of how fast they are
+// consumed, so with the unbounded lock-based queue a slow consumer shows up as queueing delay
+// rather than as a slower producer. A bounded queue (queueCapacity != 0, --queue=shm) blocks
+// enqueue once full and throttles the producer; such sends are counted in `stalls` so the
+// report can say the run stopped being open-loop.
+void producerLoop(
+    const LoadTestConfig& config,
+    double rate,
+    unsigned seed,
+    ThreadSafeQueue<Event>& eventQueue,
+    size_t queueCapacity,
+    std::atomic<uint64_t>& nextEventId,
+    std::atomic<uint64_t>& produced,
+    std::atomic<uint64_t>& stalls,
+    Clock::time_point start,
+    Clock::time_point end) {
+    ASSESSMENT_TRACE_THREAD_NAME("producer");
+    std::mt19937_64 rng(seed);
+    std::discrete_distribution<int> priorityDistribution(
+        config.priorityMix.begin(), config.priorityMix.end());
+    std::uniform_int_distribution<size_t> uniformPayload(config.payload.first, config.payload.second);
+    std::exponential_distribution<double> exponentialPayload(1.0 / static_cast<double>(config.payload.first));
+    std::uniform_int_distribution<size_t> typeDistribution(0, kEventTypes.size() - 1);
+
+    const std::chrono::duration<double, std::nano> interval(1e9 / rate);
+    uint64_t sent = 0;
+    uint64_t stalled = 0;
+
+    while (true) {
+        const auto scheduled = start + std::chrono::duration_cast<Clock::duration>(interval * static_cast<double>(sent));
+        if (scheduled >= end) {
+            break;
+        }
+        if (Clock::now() < scheduled) {
+            std::this_thread::sleep_until(scheduled);
+        }
+
+        size_t payloadSize = config.payload.first;
+        if (config.payload.distribution == PayloadDistribution::UNIFORM) {
+            payloadSize = uniformPayload(rng);
+        } else if (config.payload.distribution == PayloadDistribution::EXPONENTIAL) {
+            payloadSize = std::min(static_cast<size_t>(exponentialPayload(rng)), config.payload.maxSize());
+        }
+
+        Event event(
+            nextEventId.fetch_add(1, std::memory_order_relaxed),
+            kEventTypes[typeDistribution(rng)],
+            static_cast<Priority>(priorityDistribution(rng)),
+            std::string(payloadSize, 'x'));
+        event.setDeadline(event.getTimestamp() + config.deadline);
+        if (queueCapacity != 0 && eventQueue.size() >= queueCapacity) {
+            ++stalled;
+        }
+        eventQueue.enqueue(std::move(event));
+
+        ++sent;
+    }
+
+    produced.fetch_add(sent, std::memory_order_relaxed);
+    stalls.fetch_add(stalled, std::memory_order_relaxed);
+}
+
+TrialResult runTrial(const LoadTestConfig& config, double rate) {
+    TrialResult result;
+    result.offeredRate = rate;
+
+    auto memoryPool = std::make_shared<MemoryPool>(config.poolSize, config.blockSize);
+    if (config.poolProfile) {
+        memoryPool->enableProfiling();
+    }
+    auto eventQueue = makeQueue(config);
+#ifdef __linux__
+    if (auto* ring = dynamic_cast<assessment::queue::SharedMemoryEventQueue*>(eventQueue.get())) {
+        result.queueCapacity = ring->capacity();
+    }
+#endif
+
+    // Handlers mimic real work: stage the payload in a pool block, then release it
+    std::vector<WorkerStats> stats(config.workers);
+    std::vector<std::unique_ptr<EventProcessor>> workers;
+    for (size_t w = 0; w < config.workers; ++w) {
+        auto processor = std::make_unique<EventProcessor>(eventQueue, memoryPool);
+        WorkerStats& workerStats = stats[w];
+        auto handler = [&workerStats, &memoryPool](const Event& event) {
+            const auto& payload = event.getPayload();
+            try {
+                void* block = memoryPool->allocate(payload.size(), ASSESSMENT_POOL_SITE);
+                std::memcpy(block, payload.data(), payload.size());
+                memoryPool->deallocate(block, payload.size());
+            } catch (const std::bad_alloc&) {
+                ++workerStats.poolFailures;
+            }
+            const auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                Clock::now() - event.getTimestamp());
+            workerStats.latency.record(static_cast<uint64_t>(std::max<int64_t>(latency.count(), 0)));
+            ++workerStats.processed;
+        };
+        processor->setMaxBatchSize(config.batchSize);
+        for (EventType type : kEventTypes) {
+            if (config.batchSize > 1) {
+                processor->registerBatchHandler(type, [handler](assessment::event::EventSpan events) {
+                    for (const Event& event : events) {
+                        handler(event);
+                    }
+                });
+            } else {
+                processor->registerHandler(type, handler);
+            }
+        }
+        workers.push_back(std::move(processor));
+    }
+
+    for (auto& worker : workers) {
+        worker->start();
+    }
+
+    std::atomic<uint64_t> nextEventId{0};
+    std::atomic<uint64_t> produced{0};
+    std::atomic<uint64_t> producerStalls{0};
+    const std::clock_t cpuStart = std::clock();
+    const auto start = Clock::now() + std::chrono::milliseconds(1);
+    const auto end = start + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(config.durationSeconds));
+
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p < config.producers; ++p) {
+        producers.emplace_back(
+            producerLoop, std::cref(config), rate / static_cast<double>(config.producers),
+            static_cast<unsigned>(p + 1), std::ref(*eventQueue), result.queueCapacity,
+            std::ref(nextEventId), std::ref(produced), std::ref(producerStalls), start, end);
+    }
+
+    auto sample = [&] {
+        result.peakQueueDepth = std::max(result.peakQueueDepth, eventQueue->size());
+    };
+    while (Clock::now() < end) {
+        sample();
+        std::this_thread::sleep_for(kSampleInterval);
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    const auto drainDeadline = Clock::now() + kDrainTimeout;
+    auto processedSoFar = [&] {
+        uint64_t total = 0;
+        for (const auto& worker : workers) {
+            total += worker->getProcessedEventCount();
+        }
+        return total;
+    };
+    while (processedSoFar() < produced.load() && Clock::now() < drainDeadline) {
+        sample();
+        std::this_thread::sleep_for(kSampleInterval);
+    }
+    result.drained = processedSoFar() >= produced.load();
+    result.peakPoolUsed = memoryPool->getPeakUsedSize();
+    result.elapsedSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    eventQueue->clear();
+    for (auto& worker : workers) {
+        worker->stop();
+    }
+    result.cpuSeconds = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+
+    result.produced = produced.load();
+    result.producerStalls = producerStalls.load();
+    for (size_t w = 0; w < workers.size(); ++w) {
+        result.processed += stats[w].processed;
+        result.poolFailures += stats[w].poolFailures;
+        result.missedDeadlines += workers[w]->getMissedDeadlineCount();
+        result.latency.merge(stats[w].latency);
+    }
+    if (config.poolProfile) {
+        std::ostringstream profile;
+        memoryPool->dumpProfile(profile);
+        result.poolProfile = profile.str();
+    }
+    return result;
+}
+
+double toMicros(uint64_t nanos) {
+    return static_cast<double>(nanos) / 1000.0;
+}
+
+void printTrial(const LoadTestConfig& config, const TrialResult& result) {
+    const double processed = static_cast<double>(result.processed);
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Offered rate:       " << result.offeredRate << " events/s\n";
+    std::cout << "Sustained rate:     " << (result.elapsedSeconds > 0.0 ? processed / result.elapsedSeconds : 0.0)
+              << " events/s (" << result.processed << "/" << result.produced << " events"
+              << (result.drained ? "" : ", queue did not drain") << ")\n";
+    std::cout << "Latency (us):       p50 " << toMicros(result.latency.percentile(50.0))
+              << "  p90 " << toMicros(result.latency.percentile(90.0))
+              << "  p99 " << toMicros(result.latency.percentile(99.0))
+              << "  p99.9 " << toMicros(result.latency.percentile(99.9))
+              << "  max " << toMicros(result.latency.max()) << "\n";
+    std::cout << std::setprecision(3);
+    std::cout << "Deadline misses:    " << result.missedDeadlines << " ("
+              << (processed > 0.0 ? 100.0 * static_cast<double>(result.missedDeadlines) / processed : 0.0)
+              << "%)\n";
+    std::cout << "Pool usage:         peak " << result.peakPoolUsed << " / " << config.poolSize
+              << " bytes, " << result.poolFailures << " allocation failures\n";
+    std::cout << "Peak queue depth:   " << result.peakQueueDepth << "\n";
+    if (result.queueCapacity != 0) {
+        std::cout << "Producer stalls:    " << result.producerStalls << " sends found the "
+                  << result.queueCapacity << "-event ring full"
+                  << (result.producerStalls != 0 ? " (producers were throttled; not an open-loop run)" : "")
+                  << "\n";
+    }
+    std::cout << "CPU per event:      " << (processed > 0.0 ? result.cpuSeconds * 1e6 / processed : 0.0)
+              << " us (process CPU time, producers included)\n";
+    std::cout << result.poolProfile;
+}
+
+bool withinTarget(const LoadTestConfig& config, const TrialResult& result) {
+    // Keeping up matters as much as latency: a saturated run can look fast on the events it did process
+    const double sustained = result.elapsedSeconds > 0.0
+        ? static_cast<double>(result.processed) / result.elapsedSeconds : 0.0;
+    return result.drained &&
+           result.producerStalls == 0 &&
+           sustained >= 0.95 * result.offeredRate &&
+           toMicros(result.latency.percentile(99.0)) <= config.targetP99Us;
+}
+
+void runSearch(const LoadTestConfig& config) {
+    std::cout << "Searching for the highest rate with p99 <= " << config.targetP99Us << " us\n";
+
+    double low = config.searchMinRate;
+    double high = config.searchMaxRate;
+    double best = 0.0;
+    for (unsigned step = 0; step < config.searchSteps; ++step) {
+        const double rate = step == 0 ? low : (low + high) / 2.0;
+        const TrialResult result = runTrial(config, rate);
+        const bool pass = withinTarget(config, result);
+        std::cout << std::fixed << std::setprecision(1)
+                  << "  rate " << std::setw(11) << rate << " events/s: p99 "
+                  << toMicros(result.latency.percentile(99.0)) << " us, "
+                  << result.processed << "/" << result.produced << " processed"
+                  << (result.producerStalls != 0 ? ", ring full" : "") << " -> "
+                  << (pass ? "pass" : "fail") << std::endl;
+        std::cout << result.poolProfile;
+        if (pass) {
+            best = rate;
+            low = rate;
+        } else if (step == 0) {
+            break;
+        } else {
+            high = rate;
+        }
+    }
+
+    if (best > 0.0) {
+        std::cout << "Maximum sustainable rate: " << best << " events/s\n";
+    } else {
+        std::cout << "No rate >= " << config.searchMinRate << " events/s met the target\n";
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    LoadTestConfig config;
     try {
-        // Initialize memory pool
-        auto memoryPool = std::make_shared<assessment::memory::MemoryPool>(1024 * 1024); // 1MB pool
-        std::cout << "Memory pool initialized with 1MB capacity" << std::endl;
-
-        // Initialize queue using the LockBasedQueueFactory
-        auto eventQueue = assessment::queue::LockBasedQueueFactory::create<assessment::event::Event>();
-        std::cout << "Event queue initialized" << std::endl;
-
-        // Initialize event processor
-        auto eventProcessor = std::make_shared<assessment::event::EventProcessor>(eventQueue, memoryPool);
-        std::cout << "Event processor initialized" << std::endl;
-
-        // Initialize GPIO simulator
-        auto gpioSimulator = std::make_shared<assessment::hardware::GPIOSimulator>(eventQueue);
-        std::cout << "GPIO simulator initialized" << std::endl;
-
-        // Start event processor
-        eventProcessor->start();
-        std::cout << "Event processor started" << std::endl;
-
-        // Start GPIO simulator
-        gpioSimulator->start();
-        std::cout << "GPIO simulator started" << std::endl;
-
-        // Generate some events
-        std::cout << "\nGenerating events..." << std::endl;
-        for (int i = 0; i < 10; ++i) {
-            gpioSimulator->simulateInterrupt(i % 4);
-            std::this_thread::sleep_for(std::chrono::milliseconds(500));
-        }
-
-        // Wait for a bit to let events process
-        std::cout << "\nWaiting for events to process..." << std::endl;
-        std::this_thread::sleep_for(std::chrono::seconds(2));
-
-        // Stop GPIO simulator
-        gpioSimulator->stop();
-        std::cout << "GPIO simulator stopped" << std::endl;
-
-        // Stop event processor
-        eventProcessor->stop();
-        std::cout << "Event processor stopped" << std::endl;
-
-        // Print memory pool statistics
-        std::cout << "\nMemory pool statistics:" << std::endl;
-        std::cout << "Total size: " << memoryPool->getTotalSize() << " bytes" << std::endl;
-        std::cout << "Used: " << memoryPool->getUsedSize() << " bytes" << std::endl;
-        std::cout << "Available: " << memoryPool->getAvailableSize() << " bytes" << std::endl;
-        std::cout << "Allocations: " << memoryPool->getAllocationCount() << std::endl;
-        std::cout << "Deallocations: " << memoryPool->getDeallocationCount() << std::endl;
-
-        std::cout << "\nSimulation completed successfully" << std::endl;
+        if (!parseArguments(argc, argv, config)) {
+            printUsage(argv[0]);
+            return 0;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::cout << "Real-time System Load Test" << std::endl;
+    std::cout << "==========================" << std::endl;
+    std::cout << "Queue: " << config.queue << ", workers: " << config.workers
+              << ", batch size: " << config.batchSize
+              << ", producers: " << config.producers << ", pool: " << config.poolSize
+              << " bytes, duration: " << config.durationSeconds << " s\n" << std::endl;
+
+    try {
+        if (!config.tracePath.empty()) {
+            assessment::trace::setEnabled(true);
+        }
+        if (config.search) {
+            runSearch(config);
+        } else {
+            printTrial(config, runTrial(config, config.rate));
+        }
+        if (!config.tracePath.empty()) {
+            assessment::trace::setEnabled(false);
+            assessment::trace::writeChromeTrace(config.tracePath);
+            std::cout << "Trace written to " << config.tracePath << std::endl;
+        }
     } catch (const std::exception& e) {
         std::cerr << "ERROR: " << e.what() << std::endl;
         return 1;
     }
 
     return 0;
-} 
\ No newline at end of file
+}
@@ -0,0 +1,347 @@
+#include "assessment/memory/memory_pool.h"
+#include "assessment/trace/trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define ASSESSMENT_POOL_CALLER() __builtin_return_address(0)
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#define ASSESSMENT_POOL_CALLER() _ReturnAddress()
+#else
+#define ASSESSMENT_POOL_CALLER() nullptr
+#endif
+
+namespace assessment {
+namespace memory {
+
+namespace {
+
+uint64_t nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+size_t latencyBucket(uint64_t nanos) {
+    size_t bucket = 0;
+    while (nanos > 1 && bucket + 1 < MemoryPool::LATENCY_BUCKETS) {
+        nanos >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+} // namespace
+
+MemoryPool::MemoryPool(size_t totalSize, size_t blockSize)
+    : blockSize_(blockSize),
+      blockCount_(0),
+      nextFitHint_(0),
+      usedBlocks_(0),
+      peakUsedBlocks_(0),
+      allocationCount_(0),
+      deallocationCount_(0),
+      profiling_(false),
+      allocationLatency_{} {
+    if (totalSize == 0 || blockSize == 0) {
+        throw std::invalid_argument("MemoryPool: totalSize and blockSize must be non-zero");
+    }
+    if (totalSize < blockSize) {
+        throw std::invalid_argument("MemoryPool: totalSize must hold at least one block");
+    }
+
+    blockCount_ = totalSize / blockSize;
+    buffer_.reset(new (std::nothrow) unsigned char[blockCount_ * blockSize_]);
+    if (!buffer_) {
+        throw std::runtime_error("MemoryPool: failed to allocate backing storage");
+    }
+    blockUsed_.assign(blockCount_, false);
+    allocations_.assign(blockCount_, AllocationRecord{nullptr, nullptr, 0, 0});
+}
+
+MemoryPool::~MemoryPool() {
+    const size_t leaked = usedBlocks_.load();
+    if (leaked != 0 && isProfiling()) {
+        // The dump allocates; a failure must not escape the (noexcept) destructor
+        try {
+            std::cerr << "MemoryPool: " << leaked << " block(s) still allocated at destruction" << std::endl;
+            dumpProfile(std::cerr);
+        } catch (...) {
+        }
+        return;
+    }
+#ifndef NDEBUG
+    if (leaked != 0) {
+        std::cerr << "MemoryPool: " << leaked << " block(s) still allocated at destruction ("
+                  << allocationCount_.load() << " allocations, "
+                  << deallocationCount_.load() << " deallocations)" << std::endl;
+    }
+#endif
+}
+
+void* MemoryPool::allocate(size_t size) {
+    return allocateImpl(size, nullptr, ASSESSMENT_POOL_CALLER());
+}
+
+void* MemoryPool::allocate(size_t size, const char* site) {
+    return allocateImpl(size, site, ASSESSMENT_POOL_CALLER());
+}
+
+void* MemoryPool::allocateImpl(size_t size, const char* site, const void* caller) {
+    ASSESSMENT_TRACE_SCOPE("MemoryPool::allocate");
+    const size_t count = blocksFor(size);
+    const bool profiling = profiling_.load(std::memory_order_relaxed);
+    const uint64_t start = profiling ? nowNs() : 0;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (count > blockCount_ - usedBlocks_.load(std::memory_order_relaxed)) {
+        throw std::bad_alloc();
+    }
+
+    // Next-fit: resume after the last allocation, wrap around once
+    size_t first = findFreeRun(nextFitHint_, count);
+    if (first == blockCount_ && nextFitHint_ != 0) {
+        first = findFreeRun(0, count);
+    }
+    if (first == blockCount_) {
+        throw std::bad_alloc();
+    }
+
+    for (size_t i = first; i < first + count; ++i) {
+        blockUsed_[i] = true;
+    }
+    nextFitHint_ = (first + count) % blockCount_;
+    const size_t used = usedBlocks_.fetch_add(count, std::memory_order_relaxed) + count;
+    if (used > peakUsedBlocks_.load(std::memory_order_relaxed)) {
+        peakUsedBlocks_.store(used, std::memory_order_relaxed);
+    }
+    allocationCount_.fetch_add(1, std::memory_order_relaxed);
+    ASSESSMENT_TRACE_COUNTER("pool used bytes", used * blockSize_);
+
+    // A racing enableProfiling() takes effect on the next call
+    if (profiling) {
+        const uint64_t end = nowNs();
+        allocations_[first] = AllocationRecord{site, caller, end, count};
+        ++allocationLatency_[latencyBucket(end - start)];
+    } else {
+        allocations_[first] = AllocationRecord{nullptr, nullptr, 0, count};
+    }
+
+    return buffer_.get() + first * blockSize_;
+}
+
+void MemoryPool::deallocate(void* ptr, size_t size) {
+    if (ptr == nullptr) {
+        throw std::invalid_argument("MemoryPool: cannot deallocate null pointer");
+    }
+
+    auto* bytes = static_cast<unsigned char*>(ptr);
+    unsigned char* begin = buffer_.get();
+    if (bytes < begin || bytes >= begin + blockCount_ * blockSize_ ||
+        static_cast<size_t>(bytes - begin) % blockSize_ != 0) {
+        throw std::invalid_argument("MemoryPool: pointer does not belong to this pool");
+    }
+
+    const size_t first = static_cast<size_t>(bytes - begin) / blockSize_;
+    const size_t count = blocksFor(size);
+    if (first + count > blockCount_) {
+        throw std::invalid_argument("MemoryPool: deallocation size exceeds pool bounds");
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Checking only that the blocks are in use would let a wrong size free a neighbouring
+    // allocation; the table knows the exact extent of the allocation starting here
+    const size_t allocated = allocations_[first].blocks;
+    if (allocated == 0) {
+        throw std::invalid_argument("MemoryPool: pointer is not the start of a live allocation");
+    }
+    if (allocated != count) {
+        throw std::invalid_argument("MemoryPool: deallocation size does not match the allocation");
+    }
+    for (size_t i = first; i < first + count; ++i) {
+        blockUsed_[i] = false;
+    }
+    allocations_[first] = AllocationRecord{nullptr, nullptr, 0, 0};
+    usedBlocks_.fetch_sub(count, std::memory_order_relaxed);
+    deallocationCount_.fetch_add(1, std::memory_order_relaxed);
+}
+
+size_t MemoryPool::getTotalSize() const {
+    return blockCount_ * blockSize_;
+}
+
+size_t MemoryPool::getBlockSize() const {
+    return blockSize_;
+}
+
+size_t MemoryPool::getAllocationCount() const {
+    return allocationCount_.load(std::memory_order_relaxed);
+}
+
+size_t MemoryPool::getDeallocationCount() const {
+    return deallocationCount_.load(std::memory_order_relaxed);
+}
+
+size_t MemoryPool::getUsedSize() const {
+    return usedBlocks_.load(std::memory_order_relaxed) * blockSize_;
+}
+
+size_t MemoryPool::getPeakUsedSize() const {
+    return peakUsedBlocks_.load(std::memory_order_relaxed) * blockSize_;
+}
+
+size_t MemoryPool::getAvailableSize() const {
+    return getTotalSize() - getUsedSize();
+}
+
+bool MemoryPool::isEmpty() const {
+    return usedBlocks_.load(std::memory_order_relaxed) == 0;
+}
+
+bool MemoryPool::isFull() const {
+    return usedBlocks_.load(std::memory_order_relaxed) == blockCount_;
+}
+
+void MemoryPool::enableProfiling() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Drop attribution of earlier allocations but keep their extents
+    for (auto& record : allocations_) {
+        record = AllocationRecord{nullptr, nullptr, 0, record.blocks};
+    }
+    allocationLatency_.fill(0);
+    profiling_.store(true, std::memory_order_relaxed);
+}
+
+void MemoryPool::disableProfiling() {
+    profiling_.store(false, std::memory_order_relaxed);
+}
+
+bool MemoryPool::isProfiling() const {
+    return profiling_.load(std::memory_order_relaxed);
+}
+
+MemoryPool::FragmentationInfo MemoryPool::getFragmentation() const {
+    FragmentationInfo info{0, 0, 0, 0.0};
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t run = 0;
+    for (size_t i = 0; i <= blockCount_; ++i) {
+        if (i < blockCount_ && !blockUsed_[i]) {
+            ++run;
+            continue;
+        }
+        if (run > 0) {
+            info.freeBlocks += run;
+            ++info.freeRuns;
+            info.largestFreeRun = std::max(info.largestFreeRun, run);
+            run = 0;
+        }
+    }
+    if (info.freeBlocks > 0) {
+        info.index = 1.0 - static_cast<double>(info.largestFreeRun) / static_cast<double>(info.freeBlocks);
+    }
+    return info;
+}
+
+std::array<uint64_t, MemoryPool::LATENCY_BUCKETS> MemoryPool::getAllocationLatencyHistogram() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return allocationLatency_;
+}
+
+std::vector<MemoryPool::HolderInfo> MemoryPool::getTopHolders(size_t count) const {
+    // Snapshot live records into storage reserved up front, so the pool lock is held only for
+    // a linear copy with no heap allocation; aggregation happens after it is released
+    std::vector<AllocationRecord> live;
+    live.reserve(blockCount_);
+    const uint64_t now = nowNs();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& record : allocations_) {
+            if (record.blocks != 0 && record.timestampNs != 0) {
+                live.push_back(record);
+            }
+        }
+    }
+
+    std::sort(live.begin(), live.end(), [](const AllocationRecord& lhs, const AllocationRecord& rhs) {
+        return std::less<const void*>()(lhs.site, rhs.site) ||
+               (lhs.site == rhs.site && std::less<const void*>()(lhs.caller, rhs.caller));
+    });
+    std::vector<HolderInfo> holders;
+    for (const auto& record : live) {
+        if (holders.empty() || holders.back().site != record.site || holders.back().caller != record.caller) {
+            holders.push_back(HolderInfo{record.site, record.caller, 0, 0, 0});
+        }
+        HolderInfo& holder = holders.back();
+        holder.bytes += record.blocks * blockSize_;
+        ++holder.allocations;
+        holder.oldestAgeNs = std::max(holder.oldestAgeNs, now - std::min(now, record.timestampNs));
+    }
+
+    std::sort(holders.begin(), holders.end(), [](const HolderInfo& lhs, const HolderInfo& rhs) {
+        return lhs.bytes > rhs.bytes;
+    });
+    if (holders.size() > count) {
+        holders.resize(count);
+    }
+    return holders;
+}
+
+void MemoryPool::dumpProfile(std::ostream& out, size_t topCount) const {
+    const FragmentationInfo fragmentation = getFragmentation();
+    const auto latency = getAllocationLatencyHistogram();
+    const auto holders = getTopHolders(topCount);
+
+    const auto flags = out.flags();
+    out << "MemoryPool profile: " << getUsedSize() << "/" << getTotalSize() << " bytes used, "
+        << getAllocationCount() << " allocations, " << getDeallocationCount() << " deallocations\n";
+    out << "  fragmentation index " << std::fixed << std::setprecision(3) << fragmentation.index
+        << " (largest free run " << fragmentation.largestFreeRun << " of " << fragmentation.freeBlocks
+        << " free blocks in " << fragmentation.freeRuns << " runs)\n";
+
+    out << "  allocation latency:";
+    bool anyLatency = false;
+    for (size_t i = 0; i < latency.size(); ++i) {
+        if (latency[i] != 0) {
+            out << " <" << (uint64_t{2} << i) << "ns:" << latency[i];
+            anyLatency = true;
+        }
+    }
+    out << (anyLatency ? "\n" : " no samples\n");
+
+    out << "  top holders by bytes:" << (holders.empty() ? " none recorded\n" : "\n");
+    for (const auto& holder : holders) {
+        out << "    " << holder.bytes << " bytes in " << holder.allocations << " allocation(s), oldest "
+            << std::setprecision(3) << static_cast<double>(holder.oldestAgeNs) / 1e6 << " ms, "
+            << (holder.site ? holder.site : "unnamed site") << " (caller " << holder.caller << ")\n";
+    }
+    out.flags(flags);
+}
+
+size_t MemoryPool::findFreeRun(size_t start, size_t count) const {
+    size_t runStart = start;
+    size_t runLength = 0;
+    for (size_t i = start; i < blockCount_; ++i) {
+        if (blockUsed_[i]) {
+            runLength = 0;
+            runStart = i + 1;
+            continue;
+        }
+        if (++runLength == count) {
+            return runStart;
+        }
+    }
+    return blockCount_;
+}
+
+size_t MemoryPool::blocksFor(size_t size) const {
+    // Zero-byte requests still consume a block so every allocation has a unique address
+    return size == 0 ? 1 : (size + blockSize_ - 1) / blockSize_;
+}
+
+} // namespace memory
+} // namespace assessment
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "assessment/queue/thread_safe_queue.h"
+#include "assessment/trace/trace.h"
 #include <mutex>
 #include <queue>
 #include <condition_variable>
@@ -20,28 +21,33 @@ public:
     ~LockBasedQueue() override = default;
 
     void enqueue(const T& item) override {
+        ASSESSMENT_TRACE_SCOPE("LockBasedQueue::enqueue");
         {
             std::lock_guard<std::mutex> lock(m_mutex);
             if (m_shutdown) {
                 return;
             }
             m_queue.push(item);
+            ASSESSMENT_TRACE_COUNTER("queue depth", m_queue.size());
         }
         m_condition.notify_one();
     }
 
     void enqueue(T&& item) override {
+        ASSESSMENT_TRACE_SCOPE("LockBasedQueue::enqueue");
         {
             std::lock_guard<std::mutex> lock(m_mutex);
             if (m_shutdown) {
                 return;
             }
             m_queue.push(std::move(item));
+            ASSESSMENT_TRACE_COUNTER("queue depth", m_queue.size());
         }
         m_condition.notify_one();
     }
 
     std::optional<T> dequeue() override {
+        ASSESSMENT_TRACE_SCOPE("LockBasedQueue::dequeue");
         std::unique_lock<std::mutex> lock(m_mutex);
         m_condition.wait(lock, [this] { return m_shutdown || !m_queue.empty(); });
         
@@ -55,6 +61,7 @@ public:
     }
 
     bool tryDequeue(T& item) override {
+        ASSESSMENT_TRACE_SCOPE("LockBasedQueue::tryDequeue");
         std::lock_guard<std::mutex> lock(m_mutex);
         if (m_queue.empty()) {
             return false;
@@ -66,6 +73,7 @@ public:
     }
 
     std::optional<T> waitDequeue(std::chrono::milliseconds timeout) override {
+        ASSESSMENT_TRACE_SCOPE("LockBasedQueue::waitDequeue");
         std::unique_lock<std::mutex> lock(m_mutex);
         if (!m_condition.wait_for(lock, timeout, [this] { return m_shutdown || !m_queue.empty(); })) {
             return std::nullopt;  // Timeout
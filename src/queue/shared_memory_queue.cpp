@@ -0,0 +1,611 @@
+#ifdef __linux__
+
+#include "queue/shared_memory_queue.h"
+#include "assessment/trace/trace.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace assessment {
+namespace queue {
+
+namespace {
+
+constexpr uint32_t kMagic = 0x51534541;  // "AESQ"
+constexpr uint32_t kVersion = 2;
+constexpr size_t kCacheLine = 64;
+constexpr size_t kMaxCapacity = size_t{1} << 30;
+
+// Upper bound on a single futex sleep, so waiters periodically look for crashed peers
+constexpr std::chrono::milliseconds kRecoveryInterval{10};
+
+// How long open() waits for a concurrently created segment to finish initializing
+constexpr std::chrono::seconds kAttachTimeout{1};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "futex words must be lock-free");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "ring cursors must be lock-free");
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex words must be plain 32-bit");
+
+size_t roundUp(size_t value, size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+size_t nextPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+[[noreturn]] void throwErrno(const std::string& what) {
+    throw std::system_error(errno, std::generic_category(), "SharedMemoryEventQueue: " + what);
+}
+
+void futexWait(std::atomic<uint32_t>& word, uint32_t expected, std::chrono::nanoseconds timeout) {
+    const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+    timespec relative{};
+    relative.tv_sec = static_cast<time_t>(seconds.count());
+    relative.tv_nsec = static_cast<long>((timeout - seconds).count());
+    // Not FUTEX_PRIVATE: waiters and wakers may live in different processes
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, &relative, nullptr, 0);
+}
+
+void futexWake(std::atomic<uint32_t>& word, int count) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, count, nullptr, nullptr, 0);
+}
+
+// A slot claim packs the low 32 bits of the claimed ring position with the claimant's pid, so
+// claiming a slot and recording its owner are one atomic step
+uint64_t makeClaim(uint64_t position, uint32_t pid) {
+    return (position << 32) | pid;
+}
+
+bool claims(uint64_t claim, uint64_t position) {
+    return static_cast<uint32_t>(claim >> 32) == static_cast<uint32_t>(position);
+}
+
+int32_t claimOwner(uint64_t claim) {
+    return static_cast<int32_t>(static_cast<uint32_t>(claim));
+}
+
+uint32_t currentPid() {
+    return static_cast<uint32_t>(getpid());
+}
+
+bool processAlive(int32_t pid) {
+    return kill(pid, 0) == 0 || errno == EPERM;
+}
+
+int64_t toNanos(std::chrono::steady_clock::time_point time) {
+    if (time == std::chrono::steady_clock::time_point::max()) {
+        return std::numeric_limits<int64_t>::max();
+    }
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+std::chrono::steady_clock::time_point fromNanos(int64_t nanos) {
+    if (nanos == std::numeric_limits<int64_t>::max()) {
+        return std::chrono::steady_clock::time_point::max();
+    }
+    return std::chrono::steady_clock::time_point(
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(nanos)));
+}
+
+} // namespace
+
+struct alignas(kCacheLine) SharedMemoryEventQueue::Segment {
+    std::atomic<uint32_t> magic;
+    uint32_t version;
+    uint64_t capacity;
+    uint64_t payloadCapacity;
+    uint64_t slotStride;
+
+    // Producer and consumer cursors sit on their own cache lines
+    alignas(kCacheLine) std::atomic<uint64_t> enqueuePos;
+    alignas(kCacheLine) std::atomic<uint64_t> dequeuePos;
+
+    // Futex words are bumped on every wake so a sleeper never misses one
+    alignas(kCacheLine) std::atomic<uint32_t> notEmpty;
+    std::atomic<uint32_t> consumerWaiters;
+    std::atomic<uint32_t> notFull;
+    std::atomic<uint32_t> producerWaiters;
+    std::atomic<uint32_t> shutdown;
+    std::atomic<uint64_t> recoveredSlots;
+    std::atomic<uint64_t> discardedRecords;
+};
+
+// Fixed-size record header; the payload bytes follow it inline
+struct SharedMemoryEventQueue::Slot {
+    std::atomic<uint64_t> sequence;
+    std::atomic<uint64_t> producerClaim;
+    std::atomic<uint64_t> consumerClaim;
+    uint64_t id;
+    int64_t timestampNs;
+    int64_t deadlineNs;
+    uint32_t payloadSize;
+    uint8_t type;
+    uint8_t priority;
+    uint8_t abandoned;
+
+    unsigned char* payload() { return reinterpret_cast<unsigned char*>(this + 1); }
+};
+
+std::unique_ptr<SharedMemoryEventQueue> SharedMemoryEventQueue::create(
+    const std::string& name, size_t capacity, size_t payloadCapacity) {
+    const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        throwErrno("shm_open '" + name + "'");
+    }
+    try {
+        return initialize(fd, capacity, payloadCapacity, name);
+    } catch (...) {
+        close(fd);
+        shm_unlink(name.c_str());
+        throw;
+    }
+}
+
+std::unique_ptr<SharedMemoryEventQueue> SharedMemoryEventQueue::open(const std::string& name) {
+    const int fd = shm_open(name.c_str(), O_RDWR | O_CLOEXEC, 0);
+    if (fd < 0) {
+        throwErrno("shm_open '" + name + "'");
+    }
+    try {
+        return attach(fd, std::string());
+    } catch (...) {
+        close(fd);
+        throw;
+    }
+}
+
+std::unique_ptr<SharedMemoryEventQueue> SharedMemoryEventQueue::createAnonymous(
+    size_t capacity, size_t payloadCapacity) {
+    const int fd = memfd_create("assessment-event-queue", MFD_CLOEXEC);
+    if (fd < 0) {
+        throwErrno("memfd_create");
+    }
+    try {
+        return initialize(fd, capacity, payloadCapacity, std::string());
+    } catch (...) {
+        close(fd);
+        throw;
+    }
+}
+
+std::unique_ptr<SharedMemoryEventQueue> SharedMemoryEventQueue::openFd(int fd) {
+    const int duplicate = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+    if (duplicate < 0) {
+        throwErrno("dup");
+    }
+    try {
+        return attach(duplicate, std::string());
+    } catch (...) {
+        close(duplicate);
+        throw;
+    }
+}
+
+std::unique_ptr<SharedMemoryEventQueue> SharedMemoryEventQueue::initialize(
+    int fd, size_t capacity, size_t payloadCapacity, std::string unlinkName) {
+    if (capacity == 0 || payloadCapacity == 0) {
+        throw std::invalid_argument("SharedMemoryEventQueue: capacity and payloadCapacity must be non-zero");
+    }
+    if (capacity > kMaxCapacity || payloadCapacity > UINT32_MAX) {
+        throw std::invalid_argument("SharedMemoryEventQueue: capacity or payloadCapacity too large");
+    }
+
+    capacity = nextPowerOfTwo(capacity);
+    const size_t stride = roundUp(sizeof(Slot) + payloadCapacity, kCacheLine);
+    const size_t mappingSize = sizeof(Segment) + capacity * stride;
+
+    if (ftruncate(fd, static_cast<off_t>(mappingSize)) != 0) {
+        throwErrno("ftruncate");
+    }
+    void* mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        throwErrno("mmap");
+    }
+
+    auto* segment = new (mapping) Segment();
+    segment->version = kVersion;
+    segment->capacity = capacity;
+    segment->payloadCapacity = payloadCapacity;
+    segment->slotStride = stride;
+    segment->enqueuePos.store(0, std::memory_order_relaxed);
+    segment->dequeuePos.store(0, std::memory_order_relaxed);
+    segment->notEmpty.store(0, std::memory_order_relaxed);
+    segment->consumerWaiters.store(0, std::memory_order_relaxed);
+    segment->notFull.store(0, std::memory_order_relaxed);
+    segment->producerWaiters.store(0, std::memory_order_relaxed);
+    segment->shutdown.store(0, std::memory_order_relaxed);
+    segment->recoveredSlots.store(0, std::memory_order_relaxed);
+    segment->discardedRecords.store(0, std::memory_order_relaxed);
+
+    auto* slots = static_cast<unsigned char*>(mapping) + sizeof(Segment);
+    for (size_t i = 0; i < capacity; ++i) {
+        auto* slot = new (slots + i * stride) Slot();
+        slot->sequence.store(i, std::memory_order_relaxed);
+        // Tagged with the previous lap's position so the first lap finds the slot unclaimed
+        slot->producerClaim.store(makeClaim(i - capacity, 0), std::memory_order_relaxed);
+        slot->consumerClaim.store(makeClaim(i - capacity, 0), std::memory_order_relaxed);
+        slot->abandoned = 0;
+    }
+
+    // Publishing the magic number last lets open() detect a half-initialized segment
+    segment->magic.store(kMagic, std::memory_order_release);
+
+    return std::unique_ptr<SharedMemoryEventQueue>(
+        new SharedMemoryEventQueue(fd, mapping, mappingSize, std::move(unlinkName)));
+}
+
+std::unique_ptr<SharedMemoryEventQueue> SharedMemoryEventQueue::attach(int fd, std::string unlinkName) {
+    const auto giveUp = std::chrono::steady_clock::now() + kAttachTimeout;
+    struct stat info {};
+    while (true) {
+        if (fstat(fd, &info) != 0) {
+            throwErrno("fstat");
+        }
+        if (static_cast<size_t>(info.st_size) >= sizeof(Segment)) {
+            break;
+        }
+        if (std::chrono::steady_clock::now() >= giveUp) {
+            throw std::runtime_error("SharedMemoryEventQueue: segment was never initialized");
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    const size_t mappingSize = static_cast<size_t>(info.st_size);
+    void* mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        throwErrno("mmap");
+    }
+
+    auto* segment = static_cast<Segment*>(mapping);
+    while (segment->magic.load(std::memory_order_acquire) != kMagic) {
+        if (std::chrono::steady_clock::now() >= giveUp) {
+            munmap(mapping, mappingSize);
+            throw std::runtime_error("SharedMemoryEventQueue: segment is not an event queue");
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (segment->version != kVersion ||
+        segment->slotStride < sizeof(Slot) + segment->payloadCapacity ||
+        sizeof(Segment) + segment->capacity * segment->slotStride > mappingSize) {
+        munmap(mapping, mappingSize);
+        throw std::runtime_error("SharedMemoryEventQueue: incompatible segment layout");
+    }
+
+    return std::unique_ptr<SharedMemoryEventQueue>(
+        new SharedMemoryEventQueue(fd, mapping, mappingSize, std::move(unlinkName)));
+}
+
+SharedMemoryEventQueue::SharedMemoryEventQueue(int fd, void* mapping, size_t mappingSize, std::string unlinkName)
+    : m_fd(fd),
+      m_mapping(mapping),
+      m_mappingSize(mappingSize),
+      m_unlinkName(std::move(unlinkName)),
+      m_segment(static_cast<Segment*>(mapping)),
+      m_slots(static_cast<unsigned char*>(mapping) + sizeof(Segment)) {}
+
+SharedMemoryEventQueue::~SharedMemoryEventQueue() {
+    munmap(m_mapping, m_mappingSize);
+    close(m_fd);
+    if (!m_unlinkName.empty()) {
+        shm_unlink(m_unlinkName.c_str());
+    }
+}
+
+void SharedMemoryEventQueue::enqueue(const event::Event& item) {
+    ASSESSMENT_TRACE_SCOPE("SharedMemoryEventQueue::enqueue");
+    if (item.getPayload().size() > m_segment->payloadCapacity) {
+        throw std::length_error("SharedMemoryEventQueue: payload exceeds segment payload capacity");
+    }
+
+    while (!isShutDown() && !tryPush(item)) {
+        // Register as a waiter, then retry once so a concurrent dequeue cannot be missed
+        const uint32_t observed = m_segment->notFull.load();
+        m_segment->producerWaiters.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const bool pushed = !isShutDown() && tryPush(item);
+        if (!pushed && !isShutDown()) {
+            futexWait(m_segment->notFull, observed, kRecoveryInterval);
+        }
+        m_segment->producerWaiters.fetch_sub(1);
+        if (pushed) {
+            return;
+        }
+        recoverAbandonedSlots();
+    }
+}
+
+void SharedMemoryEventQueue::enqueue(event::Event&& item) {
+    // The event is copied into the segment either way
+    enqueue(static_cast<const event::Event&>(item));
+}
+
+std::optional<event::Event> SharedMemoryEventQueue::dequeue() {
+    ASSESSMENT_TRACE_SCOPE("SharedMemoryEventQueue::dequeue");
+    return popWait(std::chrono::steady_clock::time_point::max());
+}
+
+bool SharedMemoryEventQueue::tryDequeue(event::Event& item) {
+    ASSESSMENT_TRACE_SCOPE("SharedMemoryEventQueue::tryDequeue");
+    std::optional<event::Event> popped;
+    if (!tryPop(&popped)) {
+        return false;
+    }
+    item = std::move(*popped);
+    return true;
+}
+
+std::optional<event::Event> SharedMemoryEventQueue::waitDequeue(std::chrono::milliseconds timeout) {
+    ASSESSMENT_TRACE_SCOPE("SharedMemoryEventQueue::waitDequeue");
+    return popWait(std::chrono::steady_clock::now() + timeout);
+}
+
+bool SharedMemoryEventQueue::empty() const {
+    return size() == 0;
+}
+
+size_t SharedMemoryEventQueue::size() const {
+    const uint64_t dequeued = m_segment->dequeuePos.load(std::memory_order_acquire);
+    const uint64_t enqueued = m_segment->enqueuePos.load(std::memory_order_acquire);
+    if (enqueued <= dequeued) {
+        return 0;
+    }
+    return static_cast<size_t>(std::min<uint64_t>(enqueued - dequeued, m_segment->capacity));
+}
+
+void SharedMemoryEventQueue::clear() {
+    while (tryPop(nullptr)) {
+    }
+}
+
+void SharedMemoryEventQueue::shutdown() {
+    m_segment->shutdown.store(1);
+    m_segment->notEmpty.fetch_add(1);
+    m_segment->notFull.fetch_add(1);
+    futexWake(m_segment->notEmpty, INT_MAX);
+    futexWake(m_segment->notFull, INT_MAX);
+}
+
+bool SharedMemoryEventQueue::isShutDown() const {
+    return m_segment->shutdown.load() != 0;
+}
+
+size_t SharedMemoryEventQueue::capacity() const {
+    return static_cast<size_t>(m_segment->capacity);
+}
+
+size_t SharedMemoryEventQueue::payloadCapacity() const {
+    return static_cast<size_t>(m_segment->payloadCapacity);
+}
+
+size_t SharedMemoryEventQueue::recoveredSlotCount() const {
+    return static_cast<size_t>(m_segment->recoveredSlots.load());
+}
+
+size_t SharedMemoryEventQueue::discardedRecordCount() const {
+    return static_cast<size_t>(m_segment->discardedRecords.load());
+}
+
+void SharedMemoryEventQueue::setClaimedSlotHook(std::function<void()> hook) {
+    m_claimedSlotHook = std::move(hook);
+}
+
+SharedMemoryEventQueue::Slot& SharedMemoryEventQueue::slotAt(uint64_t position) const {
+    const uint64_t index = position & (m_segment->capacity - 1);
+    return *reinterpret_cast<Slot*>(m_slots + index * m_segment->slotStride);
+}
+
+bool SharedMemoryEventQueue::claimSlot(
+    std::atomic<uint64_t>& cursor, uint64_t lag, std::atomic<uint64_t> Slot::*claimWord, Slot** claimed,
+    uint64_t* claimedPosition) {
+    const uint32_t pid = currentPid();
+    uint64_t position = cursor.load(std::memory_order_acquire);
+    while (true) {
+        Slot& slot = slotAt(position);
+        const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<int64_t>(sequence - (position + lag));
+        if (difference < 0) {
+            return false;  // Full (producers) or empty / not yet published (consumers)
+        }
+        if (difference > 0) {
+            position = cursor.load(std::memory_order_acquire);
+            continue;
+        }
+
+        // The cursor only moves past a position once its slot is claimed, so a slot whose claim
+        // is still tagged with the previous lap is ours to take. Accepting any other tag would let
+        // a thread preempted since the sequence check claim the slot a lap late
+        uint64_t claim = (slot.*claimWord).load(std::memory_order_acquire);
+        const bool won = claims(claim, position - m_segment->capacity) &&
+            (slot.*claimWord).compare_exchange_strong(claim, makeClaim(position, pid), std::memory_order_acq_rel);
+
+        // Advance the cursor; a loser does it on behalf of a claimant that may have died first
+        uint64_t expected = position;
+        cursor.compare_exchange_strong(expected, position + 1, std::memory_order_acq_rel);
+        if (won) {
+            *claimed = &slot;
+            *claimedPosition = position;
+            return true;
+        }
+        position = cursor.load(std::memory_order_acquire);
+    }
+}
+
+bool SharedMemoryEventQueue::tryPush(const event::Event& item) {
+    Slot* slot = nullptr;
+    uint64_t position = 0;
+    if (!claimSlot(m_segment->enqueuePos, 0, &Slot::producerClaim, &slot, &position)) {
+        return false;
+    }
+
+    const std::string& payload = item.getPayload();
+    slot->id = item.getId();
+    slot->timestampNs = toNanos(item.getTimestamp());
+    slot->deadlineNs = toNanos(item.getDeadline());
+    slot->payloadSize = static_cast<uint32_t>(payload.size());
+    slot->type = static_cast<uint8_t>(item.getType());
+    slot->priority = static_cast<uint8_t>(item.getPriority());
+    slot->abandoned = 0;
+    std::memcpy(slot->payload(), payload.data(), payload.size());
+    slot->sequence.store(position + 1, std::memory_order_release);
+    ASSESSMENT_TRACE_COUNTER("queue depth", size());
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_segment->consumerWaiters.load(std::memory_order_relaxed) != 0) {
+        m_segment->notEmpty.fetch_add(1);
+        futexWake(m_segment->notEmpty, 1);
+    }
+    return true;
+}
+
+bool SharedMemoryEventQueue::tryPop(std::optional<event::Event>* item) {
+    while (true) {
+        Slot* slot = nullptr;
+        uint64_t position = 0;
+        if (!claimSlot(m_segment->dequeuePos, 1, &Slot::consumerClaim, &slot, &position)) {
+            return false;
+        }
+
+        // The record was written by another process; never trust it to index or size anything
+        const bool abandoned = slot->abandoned != 0;
+        const bool valid = !abandoned &&
+            slot->payloadSize <= m_segment->payloadCapacity &&
+            slot->type <= static_cast<uint8_t>(event::EventType::SYSTEM) &&
+            slot->priority <= static_cast<uint8_t>(event::Priority::CRITICAL);
+        if (!abandoned && !valid) {
+            m_segment->discardedRecords.fetch_add(1);
+        }
+
+        if (valid && item != nullptr) {
+            try {
+                if (m_claimedSlotHook) {
+                    m_claimedSlotHook();
+                }
+                item->emplace(
+                    slot->id,
+                    static_cast<event::EventType>(slot->type),
+                    static_cast<event::Priority>(slot->priority),
+                    std::string(reinterpret_cast<const char*>(slot->payload()), slot->payloadSize),
+                    fromNanos(slot->timestampNs));
+                (*item)->setDeadline(fromNanos(slot->deadlineNs));
+            } catch (...) {
+                // Losing this event beats wedging the ring behind a slot nobody will release
+                m_segment->discardedRecords.fetch_add(1);
+                releaseSlot(*slot, position);
+                throw;
+            }
+        }
+        releaseSlot(*slot, position);
+
+        // A slot released on behalf of a dead producer or holding a bad record carries no
+        // event; move on to the next
+        if (valid) {
+            return true;
+        }
+    }
+}
+
+void SharedMemoryEventQueue::releaseSlot(Slot& slot, uint64_t position) {
+    slot.abandoned = 0;
+    slot.sequence.store(position + m_segment->capacity, std::memory_order_release);
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_segment->producerWaiters.load(std::memory_order_relaxed) != 0) {
+        m_segment->notFull.fetch_add(1);
+        futexWake(m_segment->notFull, 1);
+    }
+}
+
+void SharedMemoryEventQueue::recoverAbandonedSlots() {
+    const uint64_t capacity = m_segment->capacity;
+
+    // Consumers stall on the head slot if its producer died after claiming it
+    const uint64_t head = m_segment->dequeuePos.load(std::memory_order_acquire);
+    Slot& headSlot = slotAt(head);
+    uint64_t producer = headSlot.producerClaim.load(std::memory_order_acquire);
+    if (headSlot.sequence.load(std::memory_order_acquire) == head &&
+        claims(producer, head) && claimOwner(producer) != 0 && !processAlive(claimOwner(producer)) &&
+        headSlot.producerClaim.compare_exchange_strong(producer, makeClaim(head, 0))) {
+        uint64_t expected = head;
+        m_segment->enqueuePos.compare_exchange_strong(expected, head + 1);
+        headSlot.abandoned = 1;
+        headSlot.sequence.store(head + 1, std::memory_order_release);
+        m_segment->recoveredSlots.fetch_add(1);
+        m_segment->notEmpty.fetch_add(1);
+        futexWake(m_segment->notEmpty, 1);
+    }
+
+    // Producers stall on the tail slot if its consumer died before releasing it
+    const uint64_t tail = m_segment->enqueuePos.load(std::memory_order_acquire);
+    if (tail < capacity) {
+        return;
+    }
+    const uint64_t consumed = tail - capacity;
+    Slot& tailSlot = slotAt(tail);
+    uint64_t consumer = tailSlot.consumerClaim.load(std::memory_order_acquire);
+    if (tailSlot.sequence.load(std::memory_order_acquire) == consumed + 1 &&
+        claims(consumer, consumed) && claimOwner(consumer) != 0 && !processAlive(claimOwner(consumer)) &&
+        tailSlot.consumerClaim.compare_exchange_strong(consumer, makeClaim(consumed, 0))) {
+        uint64_t expected = consumed;
+        m_segment->dequeuePos.compare_exchange_strong(expected, consumed + 1);
+        tailSlot.abandoned = 0;
+        tailSlot.sequence.store(tail, std::memory_order_release);
+        m_segment->recoveredSlots.fetch_add(1);
+        m_segment->notFull.fetch_add(1);
+        futexWake(m_segment->notFull, 1);
+    }
+}
+
+std::optional<event::Event> SharedMemoryEventQueue::popWait(std::chrono::steady_clock::time_point deadline) {
+    while (true) {
+        std::optional<event::Event> item;
+        if (tryPop(&item)) {
+            return item;
+        }
+        const auto now = std::chrono::steady_clock::now();
+        if (isShutDown() || now >= deadline) {
+            return std::nullopt;
+        }
+
+        // Register as a waiter, then retry once so a concurrent enqueue cannot be missed
+        const uint32_t observed = m_segment->notEmpty.load();
+        m_segment->consumerWaiters.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const bool popped = tryPop(&item);
+        if (!popped && !isShutDown()) {
+            const auto remaining = deadline == std::chrono::steady_clock::time_point::max()
+                ? std::chrono::steady_clock::duration(kRecoveryInterval)
+                : std::min<std::chrono::steady_clock::duration>(deadline - now, kRecoveryInterval);
+            futexWait(m_segment->notEmpty, observed, remaining);
+        }
+        m_segment->consumerWaiters.fetch_sub(1);
+        if (popped) {
+            return item;
+        }
+        recoverAbandonedSlots();
+    }
+}
+
+} // namespace queue
+} // namespace assessment
+
+#endif // __linux__
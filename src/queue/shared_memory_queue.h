@@ -0,0 +1,208 @@
+#pragma once
+
+#ifdef __linux__
+
+#include "assessment/queue/thread_safe_queue.h"
+#include "assessment/event/event.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace assessment {
+namespace queue {
+
+/**
+ * @brief Cross-process implementation of ThreadSafeQueue<Event>
+ *
+ * Events are stored as fixed-size records with inline payloads in a bounded lock-free MPMC
+ * ring (per-slot sequence numbers) that lives in a shared memory segment, either a named
+ * POSIX shm object or an anonymous memfd. Any number of processes and threads can map the
+ * segment and produce or consume concurrently. Blocked consumers (empty ring) and producers
+ * (full ring) sleep on process-shared futexes.
+ *
+ * A slot is claimed with a single compare-and-swap on a per-slot word that holds both the ring
+ * position and the claimant's pid, and peers help advance the ring cursors, so a slot never
+ * exists in a claimed-but-ownerless state. If a process dies between claiming a slot and
+ * finishing with it, a peer that is kept waiting on that slot notices the owner is gone and
+ * releases the slot, so a crash costs at most the events that process had in flight instead
+ * of wedging the ring.
+ *
+ * Records read back from the segment are validated (payload size, event type and priority)
+ * before they become events; malformed records are dropped and counted.
+ *
+ * Event timestamps are CLOCK_MONOTONIC based (std::chrono::steady_clock) and therefore stay
+ * comparable across processes on the same host.
+ */
+class SharedMemoryEventQueue : public ThreadSafeQueue<event::Event> {
+public:
+    /**
+     * @brief Create a named segment with shm_open(); fails if the name is taken
+     * @param name POSIX shared memory name, e.g. "/gpio-events"
+     * @param capacity Ring capacity in events, rounded up to a power of two
+     * @param payloadCapacity Maximum payload bytes per event
+     * @return The queue; the segment is unlinked when this object is destroyed
+     * @throws std::invalid_argument if capacity or payloadCapacity is 0
+     * @throws std::system_error if the segment cannot be created or mapped
+     */
+    static std::unique_ptr<SharedMemoryEventQueue> create(
+        const std::string& name, size_t capacity, size_t payloadCapacity = 256);
+
+    /**
+     * @brief Attach to a named segment created by another process
+     * @param name POSIX shared memory name
+     * @return The queue
+     * @throws std::system_error if the segment cannot be opened or mapped
+     * @throws std::runtime_error if the segment is not a compatible queue
+     */
+    static std::unique_ptr<SharedMemoryEventQueue> open(const std::string& name);
+
+    /**
+     * @brief Create an anonymous segment with memfd_create()
+     *
+     * Share it by forking or by passing fd() over a Unix socket, then attach with openFd().
+     * @param capacity Ring capacity in events, rounded up to a power of two
+     * @param payloadCapacity Maximum payload bytes per event
+     * @return The queue
+     * @throws std::invalid_argument if capacity or payloadCapacity is 0
+     * @throws std::system_error if the segment cannot be created or mapped
+     */
+    static std::unique_ptr<SharedMemoryEventQueue> createAnonymous(size_t capacity, size_t payloadCapacity = 256);
+
+    /**
+     * @brief Attach to a segment through a file descriptor; the queue takes a duplicate of fd
+     * @param fd Descriptor of a segment created by create() or createAnonymous()
+     * @return The queue
+     * @throws std::system_error if the segment cannot be mapped
+     * @throws std::runtime_error if the segment is not a compatible queue
+     */
+    static std::unique_ptr<SharedMemoryEventQueue> openFd(int fd);
+
+    ~SharedMemoryEventQueue() override;
+
+    /**
+     * @brief Enqueue an event, blocking while the ring is full
+     * @param item The event to enqueue
+     * @throws std::length_error if the payload exceeds the segment's payload capacity
+     */
+    void enqueue(const event::Event& item) override;
+    void enqueue(event::Event&& item) override;
+
+    std::optional<event::Event> dequeue() override;
+    bool tryDequeue(event::Event& item) override;
+    std::optional<event::Event> waitDequeue(std::chrono::milliseconds timeout) override;
+    bool empty() const override;
+    size_t size() const override;
+    void clear() override;
+
+    /**
+     * @brief Shut down the queue for every process attached to the segment
+     */
+    void shutdown() override;
+    bool isShutDown() const override;
+
+    /**
+     * @brief Get the segment's file descriptor, e.g. to pass it to another process
+     * @return File descriptor owned by this queue
+     */
+    int fd() const { return m_fd; }
+
+    /**
+     * @brief Get the ring capacity
+     * @return Capacity in events
+     */
+    size_t capacity() const;
+
+    /**
+     * @brief Get the maximum payload size
+     * @return Payload capacity in bytes
+     */
+    size_t payloadCapacity() const;
+
+    /**
+     * @brief Get the number of slots released because their owning process died
+     * @return Recovered slot count, shared by all attached processes
+     */
+    size_t recoveredSlotCount() const;
+
+    /**
+     * @brief Get the number of records dropped instead of dequeued
+     *
+     * Counts malformed records (e.g. written by an incompatible peer) and events lost because
+     * building them on dequeue threw, e.g. std::bad_alloc for the payload string.
+     * @return Discarded record count, shared by all attached processes
+     */
+    size_t discardedRecordCount() const;
+
+    /**
+     * @brief Install a callback that runs after a consumer claims a slot, before the event is built
+     *
+     * Test seam for the window in which this process owns a slot: the hook may throw, which is
+     * handled like failing to build the event, or end the process. Local to this process.
+     * @param hook Callback, or an empty function to remove it
+     */
+    void setClaimedSlotHook(std::function<void()> hook);
+
+private:
+    struct Segment;
+    struct Slot;
+
+    SharedMemoryEventQueue(int fd, void* mapping, size_t mappingSize, std::string unlinkName);
+
+    static std::unique_ptr<SharedMemoryEventQueue> initialize(
+        int fd, size_t capacity, size_t payloadCapacity, std::string unlinkName);
+    static std::unique_ptr<SharedMemoryEventQueue> attach(int fd, std::string unlinkName);
+
+    Slot& slotAt(uint64_t position) const;
+
+    // Claim the slot at `cursor` whose sequence is position + lag, recording this process as
+    // its owner through `claimWord`; returns false if the ring is full (producers) or empty
+    // (consumers)
+    bool claimSlot(std::atomic<uint64_t>& cursor, uint64_t lag, std::atomic<uint64_t> Slot::*claimWord,
+                   Slot** claimed, uint64_t* claimedPosition);
+
+    // Hand a consumed slot back to producers for the next lap
+    void releaseSlot(Slot& slot, uint64_t position);
+
+    // Non-blocking halves of enqueue/dequeue; return false if the ring is full/empty. tryPop
+    // releases the slot on every path, including when building the event throws
+    bool tryPush(const event::Event& item);
+    bool tryPop(std::optional<event::Event>* item);
+
+    // Release slots held by processes that no longer exist
+    void recoverAbandonedSlots();
+
+    // Block until an item may be available, the deadline passes or the queue shuts down
+    std::optional<event::Event> popWait(std::chrono::steady_clock::time_point deadline);
+
+    int m_fd;
+    void* m_mapping;
+    size_t m_mappingSize;
+    std::string m_unlinkName;
+    Segment* m_segment;
+    unsigned char* m_slots;
+    std::function<void()> m_claimedSlotHook;
+};
+
+/**
+ * @brief Factory class for creating SharedMemoryEventQueue instances
+ */
+class SharedMemoryQueueFactory {
+public:
+    /**
+     * @brief Create a queue in a new anonymous (memfd) segment
+     *
+     * @param capacity Ring capacity in events
+     * @param payloadCapacity Maximum payload bytes per event
+     * @return std::unique_ptr<ThreadSafeQueue<event::Event>> A pointer to the created queue
+     */
+    static std::unique_ptr<ThreadSafeQueue<event::Event>> create(size_t capacity, size_t payloadCapacity = 256) {
+        return SharedMemoryEventQueue::createAnonymous(capacity, payloadCapacity);
+    }
+};
+
+} // namespace queue
+} // namespace assessment
+
+#endif // __linux__
@@ -0,0 +1,152 @@
+#include "assessment/realtime/realtime_profile.h"
+
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#endif
+
+namespace assessment {
+namespace realtime {
+
+namespace {
+
+constexpr size_t kPrefaultChunk = 4096;
+
+// Prefault limit when the stack size cannot be determined; small enough for any thread stack
+// this library creates (musl's 128 KiB default is the smallest common one)
+constexpr size_t kUnknownStackPrefaultLimit = 64 * 1024;
+
+std::string describeError(const char* what, int error) {
+    return std::string(what) + ": " + std::strerror(error);
+}
+
+#ifdef __linux__
+// Each frame owns one page of stack; touching it and reading it back after the recursive call
+// keeps the compiler from collapsing the recursion into a loop.
+__attribute__((noinline)) size_t prefaultStack(size_t remaining) {
+    volatile unsigned char chunk[kPrefaultChunk];
+    for (size_t i = 0; i < kPrefaultChunk; i += 64) {
+        chunk[i] = 0;
+    }
+    size_t touched = kPrefaultChunk;
+    if (remaining > kPrefaultChunk) {
+        touched += prefaultStack(remaining - kPrefaultChunk);
+    }
+    return touched + chunk[0];
+}
+
+// Usable stack of the calling thread, or 0 if it cannot be determined
+size_t currentStackSize() {
+    pthread_attr_t attr;
+    if (pthread_getattr_np(pthread_self(), &attr) != 0) {
+        return 0;
+    }
+    size_t size = 0;
+    pthread_attr_getstacksize(&attr, &size);
+    pthread_attr_destroy(&attr);
+    return size;
+}
+#endif
+
+} // namespace
+
+std::string RealtimeReport::summary() const {
+    std::ostringstream out;
+    out << "affinity " << (affinityApplied ? "applied" : "unchanged")
+        << ", scheduling " << (schedulingApplied ? "applied" : "unchanged")
+        << ", memory " << (memoryLocked ? "locked" : "unlocked")
+        << ", stack prefaulted " << stackPrefaulted << " bytes";
+    for (const auto& issue : issues) {
+        out << "; " << issue;
+    }
+    return out.str();
+}
+
+int toNativePriority(SchedulingPolicy policy, event::Priority priority) {
+#ifdef __linux__
+    if (policy == SchedulingPolicy::DEFAULT) {
+        return 0;
+    }
+    const int native = policy == SchedulingPolicy::FIFO ? SCHED_FIFO : SCHED_RR;
+    const int low = sched_get_priority_min(native);
+    const int high = sched_get_priority_max(native);
+    // Spread the four event priorities evenly, leaving headroom above CRITICAL for kernel threads
+    const int level = static_cast<int>(priority) + 1;
+    return low + (high - low) * level / 5;
+#else
+    (void)policy;
+    (void)priority;
+    return 0;
+#endif
+}
+
+RealtimeReport applyToCurrentThread(const RealtimeProfile& profile) {
+    RealtimeReport report;
+
+#ifdef __linux__
+    if (profile.cpu >= 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(profile.cpu, &cpus);
+        const int error = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+        if (error == 0) {
+            report.affinityApplied = true;
+        } else {
+            report.issues.push_back(describeError(("pin to CPU " + std::to_string(profile.cpu)).c_str(), error));
+        }
+    }
+
+    if (profile.policy != SchedulingPolicy::DEFAULT) {
+        sched_param param{};
+        param.sched_priority = toNativePriority(profile.policy, profile.priority);
+        const int native = profile.policy == SchedulingPolicy::FIFO ? SCHED_FIFO : SCHED_RR;
+        const int error = pthread_setschedparam(pthread_self(), native, &param);
+        if (error == 0) {
+            report.schedulingApplied = true;
+        } else {
+            const char* name = profile.policy == SchedulingPolicy::FIFO ? "SCHED_FIFO" : "SCHED_RR";
+            report.issues.push_back(describeError(
+                (std::string(name) + " priority " + std::to_string(param.sched_priority)).c_str(), error));
+        }
+    }
+
+    if (profile.lockMemory) {
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) == 0) {
+            report.memoryLocked = true;
+        } else {
+            report.issues.push_back(describeError("mlockall", errno));
+        }
+    }
+
+    if (profile.stackPrefaultBytes > 0) {
+        // Stay well inside the stack so prefaulting can never overflow it
+        const size_t stackSize = currentStackSize();
+        size_t bytes = profile.stackPrefaultBytes;
+        if (stackSize == 0 && bytes > kUnknownStackPrefaultLimit) {
+            bytes = kUnknownStackPrefaultLimit;
+            report.issues.push_back("stack size unknown; stack prefault clamped to " + std::to_string(bytes) + " bytes");
+        } else if (stackSize != 0 && bytes > stackSize / 2) {
+            bytes = stackSize / 2;
+            report.issues.push_back("stack prefault clamped to " + std::to_string(bytes) + " bytes");
+        }
+        if (bytes > 0) {
+            report.stackPrefaulted = prefaultStack(bytes);
+        }
+    }
+#else
+    if (profile.cpu >= 0 || profile.policy != SchedulingPolicy::DEFAULT ||
+        profile.lockMemory || profile.stackPrefaultBytes > 0) {
+        report.issues.push_back("real-time profiles are not supported on this platform");
+    }
+#endif
+
+    return report;
+}
+
+} // namespace realtime
+} // namespace assessment
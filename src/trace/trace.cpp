@@ -0,0 +1,212 @@
+#include "assessment/trace/trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace assessment {
+namespace trace {
+
+namespace {
+
+static_assert((RECORDS_PER_THREAD & (RECORDS_PER_THREAD - 1)) == 0,
+              "RECORDS_PER_THREAD must be a power of two");
+
+// Single-producer ring owned by one thread; the exporter only reads it
+struct ThreadBuffer {
+    ThreadBuffer() : threadId(0), threadName(nullptr), head(0) {}
+
+    uint32_t threadId;
+    std::atomic<const char*> threadName;
+    std::atomic<uint64_t> head;
+    TraceRecord records[RECORDS_PER_THREAD];
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    uint32_t nextThreadId = 1;
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+// Timestamps are relative to the first trace activity in the process
+const std::chrono::steady_clock::time_point& epoch() {
+    static const auto start = std::chrono::steady_clock::now();
+    return start;
+}
+
+thread_local std::shared_ptr<ThreadBuffer> threadBuffer;
+thread_local const char* pendingThreadName = nullptr;
+
+// use_count() == 1 means the registry holds the only reference: the owning thread has exited
+bool ownerExited(const std::shared_ptr<ThreadBuffer>& buffer) {
+    return buffer.use_count() == 1;
+}
+
+// Allocation happens outside the registry lock so a thread registering never waits on an export.
+// Exited threads that recorded nothing are dropped here, so thread churn does not pile up
+// buffers between clear() calls; those with records are kept for export.
+ThreadBuffer& registerCurrentThread() {
+    auto& reg = registry();
+    auto buffer = std::make_shared<ThreadBuffer>();
+    buffer->threadName.store(pendingThreadName, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        auto unused = [](const std::shared_ptr<ThreadBuffer>& exited) {
+            return ownerExited(exited) && exited->head.load(std::memory_order_relaxed) == 0;
+        };
+        reg.buffers.erase(std::remove_if(reg.buffers.begin(), reg.buffers.end(), unused), reg.buffers.end());
+        buffer->threadId = reg.nextThreadId++;
+        reg.buffers.push_back(buffer);
+    }
+    threadBuffer = std::move(buffer);
+    return *threadBuffer;
+}
+
+ThreadBuffer& currentBuffer() {
+    if (!threadBuffer) {
+        return registerCurrentThread();
+    }
+    return *threadBuffer;
+}
+
+void writeEscaped(std::ostream& out, const char* text) {
+    out << '"';
+    for (const char* c = text ? text : "(null)"; *c; ++c) {
+        switch (*c) {
+        case '"': out << "\\\""; break;
+        case '\\': out << "\\\\"; break;
+        case '\n': out << "\\n"; break;
+        default: out << *c; break;
+        }
+    }
+    out << '"';
+}
+
+const char* phaseOf(RecordKind kind) {
+    switch (kind) {
+    case RecordKind::BEGIN: return "B";
+    case RecordKind::END: return "E";
+    case RecordKind::INSTANT: return "i";
+    case RecordKind::COUNTER: return "C";
+    }
+    return "i";
+}
+
+} // namespace
+
+void setEnabled(bool enabled) {
+    epoch();
+    detail::enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void record(RecordKind kind, const char* name, int64_t value) {
+    ThreadBuffer& buffer = currentBuffer();
+    const uint64_t head = buffer.head.load(std::memory_order_relaxed);
+    TraceRecord& slot = buffer.records[head & (RECORDS_PER_THREAD - 1)];
+    slot.timestampNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - epoch()).count());
+    slot.name = name;
+    slot.value = value;
+    slot.kind = kind;
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+void setThreadName(const char* name) {
+    pendingThreadName = name;
+    if (threadBuffer) {
+        threadBuffer->threadName.store(name, std::memory_order_relaxed);
+    } else if (isEnabled()) {
+        registerCurrentThread();
+    }
+}
+
+void clear() {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    std::vector<std::shared_ptr<ThreadBuffer>> live;
+    for (auto& buffer : reg.buffers) {
+        if (!ownerExited(buffer)) {
+            buffer->head.store(0, std::memory_order_relaxed);
+            live.push_back(std::move(buffer));
+        }
+    }
+    reg.buffers = std::move(live);
+}
+
+void writeChromeTrace(std::ostream& out) {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    auto separator = [&] {
+        out << (first ? "\n" : ",\n");
+        first = false;
+    };
+
+    for (const auto& buffer : reg.buffers) {
+        if (const char* name = buffer->threadName.load(std::memory_order_relaxed)) {
+            separator();
+            out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId
+                << ",\"args\":{\"name\":";
+            writeEscaped(out, name);
+            out << "}}";
+        }
+
+        const uint64_t head = buffer->head.load(std::memory_order_acquire);
+        const uint64_t begin = head > RECORDS_PER_THREAD ? head - RECORDS_PER_THREAD : 0;
+        // Once the ring has wrapped, the oldest ends may have lost their begins; drop them so
+        // viewers do not see unbalanced slices
+        size_t openScopes = 0;
+        for (uint64_t i = begin; i < head; ++i) {
+            const TraceRecord& rec = buffer->records[i & (RECORDS_PER_THREAD - 1)];
+            if (rec.kind == RecordKind::BEGIN) {
+                ++openScopes;
+            } else if (rec.kind == RecordKind::END) {
+                if (openScopes == 0) {
+                    continue;
+                }
+                --openScopes;
+            }
+            separator();
+            out << "{\"name\":";
+            writeEscaped(out, rec.name);
+            // Chrome expects microseconds; keep nanosecond resolution in the fraction
+            out << ",\"ph\":\"" << phaseOf(rec.kind) << "\",\"ts\":" << rec.timestampNs / 1000 << '.'
+                << static_cast<char>('0' + rec.timestampNs / 100 % 10)
+                << static_cast<char>('0' + rec.timestampNs / 10 % 10)
+                << static_cast<char>('0' + rec.timestampNs % 10)
+                << ",\"pid\":1,\"tid\":" << buffer->threadId;
+            if (rec.kind == RecordKind::INSTANT) {
+                out << ",\"s\":\"t\"";
+            } else if (rec.kind == RecordKind::COUNTER) {
+                out << ",\"args\":{\"value\":" << rec.value << '}';
+            }
+            out << '}';
+        }
+    }
+    out << "\n]}\n";
+}
+
+void writeChromeTrace(const std::string& path) {
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error("trace: cannot open '" + path + "' for writing");
+    }
+    writeChromeTrace(out);
+    if (!out) {
+        throw std::runtime_error("trace: failed writing '" + path + "'");
+    }
+}
+
+} // namespace trace
+} // namespace assessment
@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "assessment/event/event_processor.h"
+#include "queue/lockbased_queue_factory.h"
+#include "support/wait_for.h"
+
+using assessment::event::Event;
+using assessment::event::EventProcessor;
+using assessment::event::EventSpan;
+using assessment::event::EventType;
+using assessment::event::Priority;
+using assessment::queue::ThreadSafeQueue;
+using test_support::waitFor;
+
+namespace {
+
+constexpr EventType kTypes[] = {
+    EventType::HARDWARE_INTERRUPT, EventType::TIMER, EventType::USER_INPUT, EventType::SYSTEM};
+
+std::vector<uint64_t> idsOf(EventSpan events) {
+    std::vector<uint64_t> ids;
+    for (const Event& event : events) {
+        ids.push_back(event.getId());
+    }
+    return ids;
+}
+
+// Events are queued before start() so the first batch deterministically drains all of them
+class EventProcessorBatchTest : public ::testing::Test {
+protected:
+    void enqueue(uint64_t id, EventType type) {
+        queue_->enqueue(Event(id, type, Priority::MEDIUM, ""));
+    }
+
+    void runUntilProcessed(size_t count) {
+        processor_.start();
+        ASSERT_TRUE(waitFor([&] { return processor_.getProcessedEventCount() == count; }));
+        processor_.stop();
+    }
+
+    std::shared_ptr<ThreadSafeQueue<Event>> queue_ =
+        assessment::queue::LockBasedQueueFactory::create<Event>();
+    EventProcessor processor_{queue_, std::make_shared<assessment::memory::MemoryPool>(4096)};
+
+    // Written only from the processing thread, read after stop()
+    std::vector<std::vector<uint64_t>> timerBatches_;
+    std::vector<std::vector<uint64_t>> systemBatches_;
+};
+
+} // namespace
+
+TEST_F(EventProcessorBatchTest, RejectsBatchSizesOutOfRange) {
+    EXPECT_EQ(processor_.getMaxBatchSize(), EventProcessor::DEFAULT_MAX_BATCH_SIZE);
+    EXPECT_THROW(processor_.setMaxBatchSize(0), std::invalid_argument);
+    EXPECT_THROW(processor_.setMaxBatchSize(EventProcessor::MAX_BATCH_SIZE + 1), std::invalid_argument);
+    EXPECT_THROW(processor_.setMaxBatchSize(1000000000), std::invalid_argument);
+    EXPECT_EQ(processor_.getMaxBatchSize(), EventProcessor::DEFAULT_MAX_BATCH_SIZE);
+    processor_.setMaxBatchSize(EventProcessor::MAX_BATCH_SIZE);
+    EXPECT_EQ(processor_.getMaxBatchSize(), EventProcessor::MAX_BATCH_SIZE);
+}
+
+TEST_F(EventProcessorBatchTest, GroupsABatchByTypeKeepingOrderWithinEachType) {
+    processor_.setMaxBatchSize(16);
+    processor_.registerBatchHandler(EventType::TIMER, [&](EventSpan events) {
+        timerBatches_.push_back(idsOf(events));
+    });
+    processor_.registerBatchHandler(EventType::SYSTEM, [&](EventSpan events) {
+        systemBatches_.push_back(idsOf(events));
+    });
+
+    enqueue(1, EventType::TIMER);
+    enqueue(2, EventType::SYSTEM);
+    enqueue(3, EventType::TIMER);
+    enqueue(4, EventType::SYSTEM);
+    enqueue(5, EventType::TIMER);
+    runUntilProcessed(5);
+
+    ASSERT_EQ(timerBatches_.size(), 1u);
+    EXPECT_EQ(timerBatches_[0], (std::vector<uint64_t>{1, 3, 5}));
+    ASSERT_EQ(systemBatches_.size(), 1u);
+    EXPECT_EQ(systemBatches_[0], (std::vector<uint64_t>{2, 4}));
+}
+
+TEST_F(EventProcessorBatchTest, SplitsQueuedEventsIntoBatchesOfAtMostMaxBatchSize) {
+    processor_.setMaxBatchSize(4);
+    processor_.registerBatchHandler(EventType::TIMER, [&](EventSpan events) {
+        timerBatches_.push_back(idsOf(events));
+    });
+
+    for (uint64_t id = 0; id < 10; ++id) {
+        enqueue(id, EventType::TIMER);
+    }
+    runUntilProcessed(10);
+
+    std::vector<uint64_t> all;
+    for (const auto& batch : timerBatches_) {
+        EXPECT_LE(batch.size(), 4u);
+        all.insert(all.end(), batch.begin(), batch.end());
+    }
+    EXPECT_EQ(all, (std::vector<uint64_t>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+}
+
+TEST_F(EventProcessorBatchTest, MixesBatchAndPerEventHandlers) {
+    processor_.setMaxBatchSize(16);
+    std::vector<uint64_t> userInputs;
+    processor_.registerBatchHandler(EventType::TIMER, [&](EventSpan events) {
+        timerBatches_.push_back(idsOf(events));
+    });
+    processor_.registerHandler(EventType::USER_INPUT, [&](const Event& event) {
+        userInputs.push_back(event.getId());
+    });
+
+    enqueue(1, EventType::USER_INPUT);
+    enqueue(2, EventType::TIMER);
+    enqueue(3, EventType::USER_INPUT);
+    enqueue(4, EventType::TIMER);
+    // No handler for SYSTEM: consumed and counted, nothing called
+    enqueue(5, EventType::SYSTEM);
+    runUntilProcessed(5);
+
+    ASSERT_EQ(timerBatches_.size(), 1u);
+    EXPECT_EQ(timerBatches_[0], (std::vector<uint64_t>{2, 4}));
+    EXPECT_EQ(userInputs, (std::vector<uint64_t>{1, 3}));
+}
+
+TEST_F(EventProcessorBatchTest, RegisteringOneHandlerKindReplacesTheOther) {
+    processor_.setMaxBatchSize(16);
+    int perEventCalls = 0;
+    processor_.registerHandler(EventType::TIMER, [&](const Event&) { ++perEventCalls; });
+    processor_.registerBatchHandler(EventType::TIMER, [&](EventSpan events) {
+        timerBatches_.push_back(idsOf(events));
+    });
+
+    enqueue(1, EventType::TIMER);
+    enqueue(2, EventType::TIMER);
+    runUntilProcessed(2);
+
+    EXPECT_EQ(perEventCalls, 0);
+    ASSERT_EQ(timerBatches_.size(), 1u);
+    EXPECT_EQ(timerBatches_[0], (std::vector<uint64_t>{1, 2}));
+}
+
+TEST_F(EventProcessorBatchTest, CountsMissedDeadlinesAcrossABatch) {
+    processor_.setMaxBatchSize(16);
+    processor_.registerBatchHandler(EventType::TIMER, [&](EventSpan events) {
+        timerBatches_.push_back(idsOf(events));
+    });
+
+    const auto now = std::chrono::steady_clock::now();
+    for (uint64_t id = 0; id < 6; ++id) {
+        Event event(id, id % 2 == 0 ? EventType::TIMER : EventType::SYSTEM, Priority::HIGH, "");
+        if (id < 3) {
+            event.setDeadline(now - std::chrono::milliseconds(1));
+        } else if (id < 5) {
+            event.setDeadline(now + std::chrono::hours(1));
+        }
+        queue_->enqueue(std::move(event));
+    }
+    runUntilProcessed(6);
+
+    EXPECT_EQ(processor_.getMissedDeadlineCount(), 3u);
+    ASSERT_EQ(timerBatches_.size(), 1u);
+    EXPECT_EQ(timerBatches_[0], (std::vector<uint64_t>{0, 2, 4}));
+}
+
+TEST_F(EventProcessorBatchTest, DefaultBatchSizeKeepsStrictFifoOrderAcrossTypes) {
+    std::vector<uint64_t> order;
+    for (EventType type : kTypes) {
+        processor_.registerHandler(type, [&](const Event& event) { order.push_back(event.getId()); });
+    }
+    // A batch handler still sees one event at a time, in queue order
+    processor_.registerBatchHandler(EventType::SYSTEM, [&](EventSpan events) {
+        EXPECT_EQ(events.size(), 1u);
+        order.push_back(events.front().getId());
+    });
+
+    std::vector<uint64_t> expected;
+    for (uint64_t id = 0; id < 40; ++id) {
+        enqueue(id, kTypes[(id * 3) % 4]);
+        expected.push_back(id);
+    }
+    runUntilProcessed(40);
+
+    EXPECT_EQ(processor_.getMaxBatchSize(), 1u);
+    EXPECT_EQ(order, expected);
+}
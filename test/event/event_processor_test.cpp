@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+
+#include "assessment/event/event_processor.h"
+#include "queue/lockbased_queue_factory.h"
+#include "support/wait_for.h"
+
+using assessment::event::Event;
+using assessment::event::EventProcessor;
+using assessment::event::EventType;
+using assessment::event::Priority;
+using assessment::queue::ThreadSafeQueue;
+using test_support::waitFor;
+
+namespace {
+
+class EventProcessorTest : public ::testing::Test {
+protected:
+    std::shared_ptr<ThreadSafeQueue<Event>> queue_ =
+        assessment::queue::LockBasedQueueFactory::create<Event>();
+    std::shared_ptr<assessment::memory::MemoryPool> pool_ =
+        std::make_shared<assessment::memory::MemoryPool>(4096);
+};
+
+} // namespace
+
+TEST_F(EventProcessorTest, RejectsNullQueue) {
+    EXPECT_THROW(EventProcessor(nullptr, pool_), std::invalid_argument);
+}
+
+TEST_F(EventProcessorTest, StartAndStopAreIdempotent) {
+    EventProcessor processor(queue_, pool_);
+    EXPECT_FALSE(processor.isRunning());
+    processor.start();
+    processor.start();
+    EXPECT_TRUE(processor.isRunning());
+    processor.stop();
+    processor.stop();
+    EXPECT_FALSE(processor.isRunning());
+
+    // A stopped processor can be restarted
+    processor.start();
+    EXPECT_TRUE(processor.isRunning());
+}
+
+TEST_F(EventProcessorTest, DispatchesEventsToTheHandlerForTheirType) {
+    EventProcessor processor(queue_, pool_);
+    std::atomic<int> timerEvents{0};
+    std::atomic<int> systemEvents{0};
+    processor.registerHandler(EventType::TIMER, [&](const Event&) { ++timerEvents; });
+    processor.registerHandler(EventType::SYSTEM, [&](const Event&) { ++systemEvents; });
+
+    processor.start();
+    queue_->enqueue(Event(1, EventType::TIMER, Priority::LOW, "a"));
+    queue_->enqueue(Event(2, EventType::SYSTEM, Priority::LOW, "b"));
+    queue_->enqueue(Event(3, EventType::TIMER, Priority::LOW, "c"));
+    // Events without a handler are still consumed and counted
+    queue_->enqueue(Event(4, EventType::USER_INPUT, Priority::LOW, "d"));
+
+    ASSERT_TRUE(waitFor([&] { return processor.getProcessedEventCount() == 4; }));
+    EXPECT_EQ(timerEvents.load(), 2);
+    EXPECT_EQ(systemEvents.load(), 1);
+}
+
+TEST_F(EventProcessorTest, UnregisteredHandlerIsNoLongerCalled) {
+    EventProcessor processor(queue_, pool_);
+    std::atomic<int> calls{0};
+    processor.registerHandler(EventType::TIMER, [&](const Event&) { ++calls; });
+    processor.unregisterHandler(EventType::TIMER);
+
+    processor.start();
+    queue_->enqueue(Event(1, EventType::TIMER, Priority::LOW, ""));
+    ASSERT_TRUE(waitFor([&] { return processor.getProcessedEventCount() == 1; }));
+    EXPECT_EQ(calls.load(), 0);
+}
+
+TEST_F(EventProcessorTest, CountsOnlyEventsPastTheirDeadline) {
+    EventProcessor processor(queue_, pool_);
+    const auto now = std::chrono::steady_clock::now();
+
+    Event late(1, EventType::TIMER, Priority::HIGH, "");
+    late.setDeadline(now - std::chrono::milliseconds(1));
+    Event onTime(2, EventType::TIMER, Priority::HIGH, "");
+    onTime.setDeadline(now + std::chrono::hours(1));
+    Event noDeadline(3, EventType::TIMER, Priority::HIGH, "");
+
+    queue_->enqueue(late);
+    queue_->enqueue(onTime);
+    queue_->enqueue(noDeadline);
+    processor.start();
+
+    ASSERT_TRUE(waitFor([&] { return processor.getProcessedEventCount() == 3; }));
+    EXPECT_EQ(processor.getMissedDeadlineCount(), 1u);
+}
+
+TEST_F(EventProcessorTest, StopsWhenTheQueueIsShutDown) {
+    EventProcessor processor(queue_, pool_);
+    processor.start();
+    queue_->shutdown();
+    processor.stop();
+    EXPECT_FALSE(processor.isRunning());
+}
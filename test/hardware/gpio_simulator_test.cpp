@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#include "assessment/hardware/gpio_simulator.h"
+#include "queue/lockbased_queue_factory.h"
+#include "support/wait_for.h"
+
+using assessment::event::Event;
+using assessment::event::EventType;
+using assessment::hardware::GPIOSimulator;
+using assessment::queue::ThreadSafeQueue;
+using test_support::waitFor;
+
+namespace {
+
+class GPIOSimulatorTest : public ::testing::Test {
+protected:
+    std::shared_ptr<ThreadSafeQueue<Event>> queue_ =
+        assessment::queue::LockBasedQueueFactory::create<Event>();
+};
+
+} // namespace
+
+TEST_F(GPIOSimulatorTest, RejectsOutOfRangePins) {
+    GPIOSimulator simulator(queue_);
+    EXPECT_THROW(simulator.simulateInterrupt(GPIOSimulator::PIN_COUNT), std::out_of_range);
+    EXPECT_THROW(simulator.setPinValue(GPIOSimulator::PIN_COUNT, true), std::out_of_range);
+    EXPECT_THROW(simulator.getPinValue(GPIOSimulator::PIN_COUNT), std::out_of_range);
+}
+
+TEST_F(GPIOSimulatorTest, DeliversSynchronouslyWhileStopped) {
+    GPIOSimulator simulator(queue_);
+    size_t handledPin = GPIOSimulator::PIN_COUNT;
+    bool handledValue = false;
+    simulator.registerInterruptHandler(3, [&](size_t pin, bool value) {
+        handledPin = pin;
+        handledValue = value;
+    });
+
+    simulator.simulateInterrupt(3);
+    EXPECT_EQ(handledPin, 3u);
+    EXPECT_TRUE(handledValue);
+    EXPECT_TRUE(simulator.getPinValue(3));
+
+    Event event(0, EventType::TIMER, assessment::event::Priority::LOW, "");
+    ASSERT_TRUE(queue_->tryDequeue(event));
+    EXPECT_EQ(event.getType(), EventType::HARDWARE_INTERRUPT);
+    EXPECT_EQ(event.getPayload(), "pin=3 value=1");
+}
+
+TEST_F(GPIOSimulatorTest, IgnoresInterruptsOnDisabledPins) {
+    GPIOSimulator simulator(queue_);
+    std::atomic<int> calls{0};
+    simulator.registerInterruptHandler(1, [&](size_t, bool) { ++calls; });
+
+    simulator.disableInterrupts(1);
+    simulator.simulateInterrupt(1);
+    EXPECT_EQ(calls.load(), 0);
+    EXPECT_TRUE(queue_->empty());
+
+    simulator.enableInterrupts(1);
+    simulator.simulateInterrupt(1);
+    EXPECT_EQ(calls.load(), 1);
+}
+
+TEST_F(GPIOSimulatorTest, DeliversOnTheSimulationThreadWhileRunning) {
+    GPIOSimulator simulator(queue_);
+    std::atomic<int> calls{0};
+    std::atomic<bool> otherThread{false};
+    const auto caller = std::this_thread::get_id();
+    simulator.registerInterruptHandler(0, [&](size_t, bool) {
+        otherThread = std::this_thread::get_id() != caller;
+        ++calls;
+    });
+
+    simulator.start();
+    EXPECT_TRUE(simulator.isRunning());
+    simulator.simulateInterrupt(0);
+    ASSERT_TRUE(waitFor([&] { return calls.load() == 1; }));
+    EXPECT_TRUE(otherThread.load());
+    ASSERT_TRUE(waitFor([&] { return queue_->size() == 1; }));
+
+    simulator.stop();
+    EXPECT_FALSE(simulator.isRunning());
+}
+
+TEST_F(GPIOSimulatorTest, MergesRepeatedPendingInterruptsOnOnePin) {
+    GPIOSimulator simulator(queue_);
+    std::promise<void> entered;
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    std::atomic<int> pin0Calls{0};
+    std::atomic<int> pin1Calls{0};
+
+    // Hold the simulation thread inside pin 0's handler while pin 1 is raised repeatedly
+    simulator.registerInterruptHandler(0, [&](size_t, bool) {
+        if (pin0Calls++ == 0) {
+            entered.set_value();
+            released.wait();
+        }
+    });
+    simulator.registerInterruptHandler(1, [&](size_t, bool) { ++pin1Calls; });
+
+    simulator.start();
+    simulator.simulateInterrupt(0);
+    entered.get_future().wait();
+    for (int i = 0; i < 5; ++i) {
+        simulator.simulateInterrupt(1);
+    }
+    release.set_value();
+
+    ASSERT_TRUE(waitFor([&] { return queue_->size() == 2; }));
+    simulator.stop();
+    EXPECT_EQ(pin0Calls.load(), 1);
+    EXPECT_EQ(pin1Calls.load(), 1);
+    EXPECT_EQ(queue_->size(), 2u);
+}
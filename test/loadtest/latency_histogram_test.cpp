@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "loadtest/latency_histogram.h"
+
+using assessment::loadtest::LatencyHistogram;
+
+TEST(LatencyHistogramTest, SmallValuesAreExact) {
+    LatencyHistogram histogram;
+    for (uint64_t value = 0; value < LatencyHistogram::SUB_BUCKET_COUNT; ++value) {
+        histogram.record(value);
+    }
+    EXPECT_EQ(histogram.count(), LatencyHistogram::SUB_BUCKET_COUNT);
+    EXPECT_EQ(histogram.min(), 0u);
+    EXPECT_EQ(histogram.percentile(50.0), LatencyHistogram::SUB_BUCKET_COUNT / 2 - 1);
+}
+
+TEST(LatencyHistogramTest, RelativeErrorIsBoundedBySubBucketResolution) {
+    // Every value is reported as the upper bound of its bucket, at most 1/SUB_BUCKET_COUNT above it
+    for (uint64_t value : {uint64_t{33}, uint64_t{1000}, uint64_t{123456}, uint64_t{987654321},
+                           uint64_t{1} << 40, (uint64_t{1} << 40) + 1}) {
+        LatencyHistogram histogram;
+        histogram.record(value);
+        histogram.record(UINT64_MAX);
+        const uint64_t reported = histogram.percentile(50.0);
+        EXPECT_GE(reported, value);
+        EXPECT_LE(reported - value, value / LatencyHistogram::SUB_BUCKET_COUNT) << value;
+    }
+}
+
+TEST(LatencyHistogramTest, NeighbouringValuesInTheSameOctaveAreDistinguished) {
+    // 1024 and 1056 differ by 1/32; with SUB_BUCKET_COUNT sub-buckets per octave they do not share a bucket
+    LatencyHistogram histogram;
+    histogram.record(1024);
+    histogram.record(1056);
+    histogram.record(UINT64_MAX);
+    EXPECT_LT(histogram.percentile(10.0), 1056u);
+}
+
+TEST(LatencyHistogramTest, MergeCombinesCountsAndExtremes) {
+    LatencyHistogram first;
+    LatencyHistogram second;
+    first.record(10);
+    second.record(5000);
+    second.record(20);
+    first.merge(second);
+
+    EXPECT_EQ(first.count(), 3u);
+    EXPECT_EQ(first.min(), 10u);
+    EXPECT_EQ(first.max(), 5000u);
+    EXPECT_EQ(first.percentile(100.0), 5000u);
+    EXPECT_DOUBLE_EQ(first.mean(), (10.0 + 5000.0 + 20.0) / 3.0);
+
+    first.reset();
+    EXPECT_EQ(first.count(), 0u);
+    EXPECT_EQ(first.percentile(99.0), 0u);
+}
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "assessment/memory/memory_pool.h"
+
+using assessment::memory::MemoryPool;
+
+namespace {
+
+constexpr size_t kBlockSize = 64;
+
+} // namespace
+
+TEST(MemoryPoolProfilingTest, FragmentationOfAnEmptyPoolIsZero) {
+    MemoryPool pool(8 * kBlockSize, kBlockSize);
+    const auto info = pool.getFragmentation();
+    EXPECT_EQ(info.freeBlocks, 8u);
+    EXPECT_EQ(info.freeRuns, 1u);
+    EXPECT_EQ(info.largestFreeRun, 8u);
+    EXPECT_DOUBLE_EQ(info.index, 0.0);
+}
+
+TEST(MemoryPoolProfilingTest, FragmentationReportsLargestFreeRunAndIndex) {
+    MemoryPool pool(8 * kBlockSize, kBlockSize);
+    std::vector<void*> blocks;
+    for (int i = 0; i < 8; ++i) {
+        blocks.push_back(pool.allocate(kBlockSize));
+    }
+    // Free blocks 0, 2-3 and 5-7: runs of 1, 2 and 3
+    for (size_t i : {0u, 2u, 3u, 5u, 6u, 7u}) {
+        pool.deallocate(blocks[i], kBlockSize);
+    }
+
+    const auto info = pool.getFragmentation();
+    EXPECT_EQ(info.freeBlocks, 6u);
+    EXPECT_EQ(info.freeRuns, 3u);
+    EXPECT_EQ(info.largestFreeRun, 3u);
+    EXPECT_DOUBLE_EQ(info.index, 0.5);
+
+    pool.deallocate(blocks[1], kBlockSize);
+    pool.deallocate(blocks[4], kBlockSize);
+}
+
+TEST(MemoryPoolProfilingTest, FragmentationOfAFullPoolIsZero) {
+    MemoryPool pool(2 * kBlockSize, kBlockSize);
+    void* all = pool.allocate(2 * kBlockSize);
+    const auto info = pool.getFragmentation();
+    EXPECT_EQ(info.freeBlocks, 0u);
+    EXPECT_EQ(info.largestFreeRun, 0u);
+    EXPECT_DOUBLE_EQ(info.index, 0.0);
+    pool.deallocate(all, 2 * kBlockSize);
+}
+
+TEST(MemoryPoolProfilingTest, TopHoldersAreEmptyUnlessProfiling) {
+    MemoryPool pool(8 * kBlockSize, kBlockSize);
+    void* block = pool.allocate(kBlockSize, ASSESSMENT_POOL_SITE);
+    EXPECT_FALSE(pool.isProfiling());
+    EXPECT_TRUE(pool.getTopHolders(10).empty());
+    pool.deallocate(block, kBlockSize);
+}
+
+TEST(MemoryPoolProfilingTest, AllocationsBeforeEnablingAreNotAttributed) {
+    MemoryPool pool(8 * kBlockSize, kBlockSize);
+    void* early = pool.allocate(2 * kBlockSize, ASSESSMENT_POOL_SITE);
+    pool.enableProfiling();
+    void* late = pool.allocate(kBlockSize, ASSESSMENT_POOL_SITE);
+
+    const auto holders = pool.getTopHolders(10);
+    ASSERT_EQ(holders.size(), 1u);
+    EXPECT_EQ(holders[0].bytes, kBlockSize);
+
+    // Enabling profiling keeps the size check for allocations it does not attribute
+    EXPECT_THROW(pool.deallocate(early, kBlockSize), std::invalid_argument);
+    pool.deallocate(early, 2 * kBlockSize);
+    pool.deallocate(late, kBlockSize);
+    EXPECT_TRUE(pool.getTopHolders(10).empty());
+}
+
+TEST(MemoryPoolProfilingTest, TopHoldersAggregateBySite) {
+    MemoryPool pool(32 * kBlockSize, kBlockSize);
+    pool.enableProfiling();
+
+    const char* const small = ASSESSMENT_POOL_SITE;
+    const char* const large = ASSESSMENT_POOL_SITE;
+    EXPECT_NE(std::string(small), std::string(large));
+
+    std::vector<void*> smallBlocks;
+    for (int i = 0; i < 3; ++i) {
+        smallBlocks.push_back(pool.allocate(kBlockSize, small));
+    }
+    void* largeBlock = pool.allocate(8 * kBlockSize, large);
+    void* released = pool.allocate(16 * kBlockSize, large);
+    pool.deallocate(released, 16 * kBlockSize);
+
+    const auto holders = pool.getTopHolders(10);
+    ASSERT_EQ(holders.size(), 2u);
+    EXPECT_EQ(holders[0].site, large);
+    EXPECT_EQ(holders[0].bytes, 8 * kBlockSize);
+    EXPECT_EQ(holders[0].allocations, 1u);
+    EXPECT_EQ(holders[1].site, small);
+    EXPECT_EQ(holders[1].bytes, 3 * kBlockSize);
+    EXPECT_EQ(holders[1].allocations, 3u);
+    EXPECT_GE(holders[1].oldestAgeNs, holders[0].oldestAgeNs);
+
+    const auto top = pool.getTopHolders(1);
+    ASSERT_EQ(top.size(), 1u);
+    EXPECT_EQ(top[0].site, large);
+
+    std::ostringstream dump;
+    pool.dumpProfile(dump);
+    EXPECT_NE(dump.str().find(small), std::string::npos);
+    EXPECT_NE(dump.str().find("fragmentation index"), std::string::npos);
+
+    for (void* block : smallBlocks) {
+        pool.deallocate(block, kBlockSize);
+    }
+    pool.deallocate(largeBlock, 8 * kBlockSize);
+    EXPECT_TRUE(pool.getTopHolders(10).empty());
+}
+
+TEST(MemoryPoolProfilingTest, LatencyHistogramCountsProfiledAllocations) {
+    MemoryPool pool(16 * kBlockSize, kBlockSize);
+    void* unprofiled = pool.allocate(kBlockSize);
+    pool.deallocate(unprofiled, kBlockSize);
+
+    pool.enableProfiling();
+    for (int i = 0; i < 5; ++i) {
+        void* block = pool.allocate(kBlockSize, ASSESSMENT_POOL_SITE);
+        pool.deallocate(block, kBlockSize);
+    }
+    pool.disableProfiling();
+    void* afterwards = pool.allocate(kBlockSize);
+    pool.deallocate(afterwards, kBlockSize);
+
+    const auto histogram = pool.getAllocationLatencyHistogram();
+    EXPECT_EQ(std::accumulate(histogram.begin(), histogram.end(), uint64_t{0}), 5u);
+
+    // Re-enabling starts a fresh profile
+    pool.enableProfiling();
+    const auto cleared = pool.getAllocationLatencyHistogram();
+    EXPECT_EQ(std::accumulate(cleared.begin(), cleared.end(), uint64_t{0}), 0u);
+}
+
+TEST(MemoryPoolProfilingTest, DestructorDumpsProfileForLeakedBlocks) {
+    ::testing::internal::CaptureStderr();
+    {
+        MemoryPool pool(4 * kBlockSize, kBlockSize);
+        pool.enableProfiling();
+        pool.allocate(kBlockSize, "leaky site");
+    }
+    const std::string output = ::testing::internal::GetCapturedStderr();
+    EXPECT_NE(output.find("1 block(s) still allocated"), std::string::npos);
+    EXPECT_NE(output.find("leaky site"), std::string::npos);
+}
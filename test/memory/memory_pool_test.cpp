@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+
+#include "assessment/memory/memory_pool.h"
+
+using assessment::memory::MemoryPool;
+
+namespace {
+
+constexpr size_t kBlockSize = 64;
+
+unsigned char* asBytes(void* ptr) {
+    return static_cast<unsigned char*>(ptr);
+}
+
+} // namespace
+
+TEST(MemoryPoolTest, RejectsInvalidConstruction) {
+    EXPECT_THROW(MemoryPool(0, kBlockSize), std::invalid_argument);
+    EXPECT_THROW(MemoryPool(1024, 0), std::invalid_argument);
+    EXPECT_THROW(MemoryPool(kBlockSize - 1, kBlockSize), std::invalid_argument);
+}
+
+TEST(MemoryPoolTest, TracksUsageInWholeBlocks) {
+    MemoryPool pool(4 * kBlockSize, kBlockSize);
+    EXPECT_TRUE(pool.isEmpty());
+    EXPECT_EQ(pool.getTotalSize(), 4 * kBlockSize);
+
+    void* small = pool.allocate(1);
+    void* large = pool.allocate(kBlockSize + 1);
+    EXPECT_EQ(pool.getUsedSize(), 3 * kBlockSize);
+    EXPECT_EQ(pool.getAvailableSize(), kBlockSize);
+    EXPECT_EQ(pool.getAllocationCount(), 2u);
+
+    pool.deallocate(small, 1);
+    pool.deallocate(large, kBlockSize + 1);
+    EXPECT_TRUE(pool.isEmpty());
+    EXPECT_EQ(pool.getDeallocationCount(), 2u);
+}
+
+TEST(MemoryPoolTest, ZeroByteAllocationsGetDistinctBlocks) {
+    MemoryPool pool(2 * kBlockSize, kBlockSize);
+    void* first = pool.allocate(0);
+    void* second = pool.allocate(0);
+    EXPECT_NE(first, second);
+    EXPECT_TRUE(pool.isFull());
+    pool.deallocate(first, 0);
+    pool.deallocate(second, 0);
+}
+
+TEST(MemoryPoolTest, NextFitResumesAfterLastAllocationAndWrapsAround) {
+    MemoryPool pool(4 * kBlockSize, kBlockSize);
+    void* block0 = pool.allocate(kBlockSize);
+    void* block1 = pool.allocate(kBlockSize);
+    void* block2 = pool.allocate(kBlockSize);
+    EXPECT_EQ(asBytes(block1) - asBytes(block0), static_cast<ptrdiff_t>(kBlockSize));
+    EXPECT_EQ(asBytes(block2) - asBytes(block0), static_cast<ptrdiff_t>(2 * kBlockSize));
+
+    // Block 0 is free again, but next-fit continues from block 3 before wrapping
+    pool.deallocate(block0, kBlockSize);
+    void* block3 = pool.allocate(kBlockSize);
+    EXPECT_EQ(asBytes(block3) - asBytes(block0), static_cast<ptrdiff_t>(3 * kBlockSize));
+
+    void* wrapped = pool.allocate(kBlockSize);
+    EXPECT_EQ(wrapped, block0);
+    EXPECT_TRUE(pool.isFull());
+
+    for (void* block : {wrapped, block1, block2, block3}) {
+        pool.deallocate(block, kBlockSize);
+    }
+}
+
+TEST(MemoryPoolTest, ThrowsBadAllocWhenFreeSpaceIsFragmented) {
+    MemoryPool pool(4 * kBlockSize, kBlockSize);
+    void* blocks[4];
+    for (auto& block : blocks) {
+        block = pool.allocate(kBlockSize);
+    }
+    pool.deallocate(blocks[0], kBlockSize);
+    pool.deallocate(blocks[2], kBlockSize);
+
+    // Two free blocks, but no two contiguous ones
+    EXPECT_EQ(pool.getAvailableSize(), 2 * kBlockSize);
+    EXPECT_THROW(pool.allocate(2 * kBlockSize), std::bad_alloc);
+    EXPECT_THROW(pool.allocate(5 * kBlockSize), std::bad_alloc);
+
+    pool.deallocate(blocks[1], kBlockSize);
+    pool.deallocate(blocks[3], kBlockSize);
+    void* all = pool.allocate(4 * kBlockSize);
+    EXPECT_TRUE(pool.isFull());
+    pool.deallocate(all, 4 * kBlockSize);
+}
+
+TEST(MemoryPoolTest, DeallocateRejectsInvalidPointers) {
+    MemoryPool pool(4 * kBlockSize, kBlockSize);
+    void* block = pool.allocate(kBlockSize);
+    int foreign = 0;
+
+    EXPECT_THROW(pool.deallocate(nullptr, kBlockSize), std::invalid_argument);
+    EXPECT_THROW(pool.deallocate(&foreign, sizeof(foreign)), std::invalid_argument);
+    EXPECT_THROW(pool.deallocate(asBytes(block) + 1, kBlockSize), std::invalid_argument);
+    EXPECT_THROW(pool.deallocate(block, 5 * kBlockSize), std::invalid_argument);
+
+    pool.deallocate(block, kBlockSize);
+    EXPECT_THROW(pool.deallocate(block, kBlockSize), std::invalid_argument);
+    EXPECT_TRUE(pool.isEmpty());
+    EXPECT_EQ(pool.getDeallocationCount(), 1u);
+}
+
+TEST(MemoryPoolTest, DeallocateRejectsSizesThatDoNotMatchTheAllocation) {
+    MemoryPool pool(4 * kBlockSize, kBlockSize);
+    void* single = pool.allocate(kBlockSize);
+    void* neighbour = pool.allocate(2 * kBlockSize);
+    ASSERT_EQ(asBytes(neighbour), asBytes(single) + kBlockSize);
+
+    // Too large would free the neighbour, too small would strand part of the allocation
+    EXPECT_THROW(pool.deallocate(single, 2 * kBlockSize), std::invalid_argument);
+    EXPECT_THROW(pool.deallocate(neighbour, kBlockSize), std::invalid_argument);
+    // Inside a live allocation but not its start
+    EXPECT_THROW(pool.deallocate(asBytes(neighbour) + kBlockSize, kBlockSize), std::invalid_argument);
+    EXPECT_EQ(pool.getUsedSize(), 3 * kBlockSize);
+    EXPECT_EQ(pool.getDeallocationCount(), 0u);
+
+    // Any size rounding to the same block count matches
+    pool.deallocate(single, 1);
+    pool.deallocate(neighbour, kBlockSize + 1);
+    EXPECT_TRUE(pool.isEmpty());
+}
+
+TEST(MemoryPoolTest, PeakUsedSizeKeepsTheHighWaterMark) {
+    MemoryPool pool(8 * kBlockSize, kBlockSize);
+    EXPECT_EQ(pool.getPeakUsedSize(), 0u);
+
+    void* first = pool.allocate(3 * kBlockSize);
+    void* second = pool.allocate(2 * kBlockSize);
+    pool.deallocate(first, 3 * kBlockSize);
+    pool.deallocate(second, 2 * kBlockSize);
+    void* third = pool.allocate(kBlockSize);
+
+    EXPECT_EQ(pool.getUsedSize(), kBlockSize);
+    EXPECT_EQ(pool.getPeakUsedSize(), 5 * kBlockSize);
+    pool.deallocate(third, kBlockSize);
+}
@@ -0,0 +1,426 @@
+#ifdef __linux__
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "queue/shared_memory_queue.h"
+
+using assessment::event::Event;
+using assessment::event::EventType;
+using assessment::event::Priority;
+using assessment::queue::SharedMemoryEventQueue;
+
+namespace {
+
+constexpr auto kTimeout = std::chrono::seconds(5);
+
+const std::string kPayload(64, 'p');
+
+Event makeEvent(uint64_t id, const std::string& payload = kPayload) {
+    return Event(id, static_cast<EventType>(id % 4), static_cast<Priority>(id % 4), payload);
+}
+
+// Run `body` in a forked child; its return value becomes the child's exit status
+pid_t forkChild(const std::function<int()>& body) {
+    const pid_t pid = fork();
+    if (pid == 0) {
+        int status = 100;
+        try {
+            status = body();
+        } catch (...) {
+        }
+        _exit(status);
+    }
+    return pid;
+}
+
+int waitChild(pid_t pid) {
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return status;
+}
+
+bool exitedCleanly(int status) {
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+// Enqueue on another thread so a wedged ring fails the test instead of hanging it
+::testing::AssertionResult enqueueWithin(SharedMemoryEventQueue& queue, Event event) {
+    auto pushed = std::async(std::launch::async, [&queue, event] { queue.enqueue(event); });
+    if (pushed.wait_for(kTimeout) != std::future_status::ready) {
+        queue.shutdown();
+        return ::testing::AssertionFailure() << "enqueue still blocked after " << kTimeout.count() << " s";
+    }
+    return ::testing::AssertionSuccess();
+}
+
+// Many threads on a tiny ring keep every slot contended, so a thread preempted mid-claim finds
+// its slot a lap further on; a lap-late claim shows up as duplicates, losses or a wedged ring
+void runThreadedStress(size_t capacity) {
+    constexpr uint64_t kThreads = 8;
+    constexpr uint64_t kEventsPerProducer = 20000;
+    constexpr uint64_t kTotal = kThreads * kEventsPerProducer;
+    auto queue = SharedMemoryEventQueue::createAnonymous(capacity, 8);
+
+    std::atomic<uint64_t> consumed{0};
+    std::vector<std::atomic<uint32_t>> deliveries(kTotal);
+    std::atomic<uint64_t> reordered{0};
+
+    std::vector<std::thread> threads;
+    for (uint64_t p = 0; p < kThreads; ++p) {
+        threads.emplace_back([&, p] {
+            for (uint64_t i = 0; i < kEventsPerProducer && !queue->isShutDown(); ++i) {
+                queue->enqueue(makeEvent(p * kEventsPerProducer + i, ""));
+            }
+        });
+    }
+    for (uint64_t c = 0; c < kThreads; ++c) {
+        threads.emplace_back([&] {
+            // A consumer sees each producer's events in the order they were produced
+            std::vector<uint64_t> nextMinimum(kThreads, 0);
+            while (consumed.load() < kTotal && !queue->isShutDown()) {
+                if (auto event = queue->waitDequeue(std::chrono::milliseconds(10))) {
+                    const uint64_t id = event->getId();
+                    const uint64_t p = id / kEventsPerProducer;
+                    if (id < p * kEventsPerProducer + nextMinimum[p]) {
+                        reordered.fetch_add(1);
+                    }
+                    nextMinimum[p] = id % kEventsPerProducer + 1;
+                    deliveries[id].fetch_add(1);
+                    consumed.fetch_add(1);
+                }
+            }
+        });
+    }
+
+    // A wedged ring stops making progress; shut it down so the threads exit and the test fails
+    uint64_t lastConsumed = 0;
+    auto lastProgress = std::chrono::steady_clock::now();
+    while (consumed.load() < kTotal && std::chrono::steady_clock::now() - lastProgress < kTimeout) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        if (consumed.load() != lastConsumed) {
+            lastConsumed = consumed.load();
+            lastProgress = std::chrono::steady_clock::now();
+        }
+    }
+    const bool drained = consumed.load() >= kTotal;
+    queue->shutdown();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_TRUE(drained) << "ring wedged after " << consumed.load() << " of " << kTotal << " events";
+    uint64_t lost = 0;
+    uint64_t duplicated = 0;
+    for (const auto& count : deliveries) {
+        lost += count.load() == 0 ? 1 : 0;
+        duplicated += count.load() > 1 ? 1 : 0;
+    }
+    EXPECT_EQ(lost, 0u);
+    EXPECT_EQ(duplicated, 0u);
+    EXPECT_EQ(reordered.load(), 0u);
+    EXPECT_EQ(queue->discardedRecordCount(), 0u);
+    EXPECT_EQ(queue->recoveredSlotCount(), 0u);
+}
+
+} // namespace
+
+
+TEST(SharedMemoryEventQueueTest, ForkedProducerDeliversEventsInFifoOrder) {
+    constexpr uint64_t kEvents = 10000;
+    auto queue = SharedMemoryEventQueue::createAnonymous(64, 64);
+
+    const pid_t producer = forkChild([&] {
+        for (uint64_t i = 0; i < kEvents; ++i) {
+            Event event = makeEvent(i, "event-" + std::to_string(i));
+            event.setDeadline(event.getTimestamp() + std::chrono::seconds(i));
+            queue->enqueue(std::move(event));
+        }
+        return 0;
+    });
+    ASSERT_GT(producer, 0);
+
+    for (uint64_t i = 0; i < kEvents; ++i) {
+        auto event = queue->waitDequeue(kTimeout);
+        ASSERT_TRUE(event.has_value()) << "event " << i << " never arrived";
+        EXPECT_EQ(event->getId(), i);
+        EXPECT_EQ(event->getType(), static_cast<EventType>(i % 4));
+        EXPECT_EQ(event->getPriority(), static_cast<Priority>(i % 4));
+        EXPECT_EQ(event->getPayload(), "event-" + std::to_string(i));
+        EXPECT_EQ(event->getDeadline() - event->getTimestamp(), std::chrono::seconds(i));
+    }
+    EXPECT_TRUE(exitedCleanly(waitChild(producer)));
+    EXPECT_TRUE(queue->empty());
+}
+
+TEST(SharedMemoryEventQueueTest, ForkedProducersAndConsumersDeliverEachEventOnce) {
+    constexpr uint64_t kProducers = 3;
+    constexpr uint64_t kEventsPerProducer = 5000;
+    constexpr uint64_t kTotal = kProducers * kEventsPerProducer;
+    auto queue = SharedMemoryEventQueue::createAnonymous(128, 64);
+
+    std::vector<pid_t> producers;
+    for (uint64_t p = 0; p < kProducers; ++p) {
+        producers.push_back(forkChild([&, p] {
+            for (uint64_t i = 0; i < kEventsPerProducer; ++i) {
+                queue->enqueue(makeEvent(p * kEventsPerProducer + i));
+            }
+            return 0;
+        }));
+        ASSERT_GT(producers.back(), 0);
+    }
+
+    std::atomic<uint64_t> consumed{0};
+    std::vector<std::vector<uint64_t>> received(2);
+    std::vector<std::thread> consumers;
+    for (auto& ids : received) {
+        consumers.emplace_back([&] {
+            const auto giveUp = std::chrono::steady_clock::now() + kTimeout * 4;
+            while (consumed.load() < kTotal && std::chrono::steady_clock::now() < giveUp) {
+                if (auto event = queue->waitDequeue(std::chrono::milliseconds(10))) {
+                    ids.push_back(event->getId());
+                    consumed.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto& consumer : consumers) {
+        consumer.join();
+    }
+    for (pid_t producer : producers) {
+        EXPECT_TRUE(exitedCleanly(waitChild(producer)));
+    }
+
+    std::vector<uint64_t> all;
+    for (const auto& ids : received) {
+        // Each consumer sees every producer's events in the order they were produced
+        std::vector<uint64_t> lastSeen(kProducers, 0);
+        std::vector<bool> seenAny(kProducers, false);
+        for (uint64_t id : ids) {
+            const uint64_t p = id / kEventsPerProducer;
+            EXPECT_TRUE(!seenAny[p] || id > lastSeen[p]) << "event " << id << " out of order";
+            seenAny[p] = true;
+            lastSeen[p] = id;
+        }
+        all.insert(all.end(), ids.begin(), ids.end());
+    }
+    std::sort(all.begin(), all.end());
+    ASSERT_EQ(all.size(), kTotal);
+    for (uint64_t i = 0; i < kTotal; ++i) {
+        ASSERT_EQ(all[i], i);
+    }
+}
+
+TEST(SharedMemoryEventQueueTest, ThreadedProducersAndConsumersOnATinyRing) {
+    runThreadedStress(2);
+}
+
+TEST(SharedMemoryEventQueueTest, ThreadedProducersAndConsumersOnASmallRing) {
+    runThreadedStress(64);
+}
+
+TEST(SharedMemoryEventQueueTest, EnqueueBlocksWhileTheRingIsFull) {
+    auto queue = SharedMemoryEventQueue::createAnonymous(2, 64);
+    EXPECT_EQ(queue->capacity(), 2u);
+    queue->enqueue(makeEvent(0));
+    queue->enqueue(makeEvent(1));
+    EXPECT_EQ(queue->size(), 2u);
+
+    std::atomic<bool> pushed{false};
+    std::thread producer([&] {
+        queue->enqueue(makeEvent(2));
+        pushed = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(pushed.load());
+
+    Event event = makeEvent(99);
+    ASSERT_TRUE(queue->tryDequeue(event));
+    EXPECT_EQ(event.getId(), 0u);
+    producer.join();
+    EXPECT_TRUE(pushed.load());
+
+    for (uint64_t id : {1u, 2u}) {
+        ASSERT_TRUE(queue->tryDequeue(event));
+        EXPECT_EQ(event.getId(), id);
+    }
+    EXPECT_FALSE(queue->tryDequeue(event));
+}
+
+TEST(SharedMemoryEventQueueTest, RejectsPayloadsAboveCapacity) {
+    auto queue = SharedMemoryEventQueue::createAnonymous(4, 16);
+    EXPECT_THROW(queue->enqueue(makeEvent(0, std::string(17, 'x'))), std::length_error);
+    EXPECT_TRUE(queue->empty());
+}
+
+TEST(SharedMemoryEventQueueTest, ShutdownFromAnotherProcessWakesBlockedConsumer) {
+    auto queue = SharedMemoryEventQueue::createAnonymous(4, 64);
+    auto popped = std::async(std::launch::async, [&] { return queue->dequeue(); });
+
+    const pid_t peer = forkChild([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        queue->shutdown();
+        return 0;
+    });
+    ASSERT_GT(peer, 0);
+
+    ASSERT_EQ(popped.wait_for(kTimeout), std::future_status::ready);
+    EXPECT_FALSE(popped.get().has_value());
+    EXPECT_TRUE(queue->isShutDown());
+    EXPECT_TRUE(exitedCleanly(waitChild(peer)));
+}
+
+TEST(SharedMemoryEventQueueTest, ShutdownFromAnotherProcessWakesBlockedProducer) {
+    auto queue = SharedMemoryEventQueue::createAnonymous(1, 64);
+    queue->enqueue(makeEvent(0));
+    auto pushed = std::async(std::launch::async, [&] { queue->enqueue(makeEvent(1)); });
+
+    const pid_t peer = forkChild([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        queue->shutdown();
+        return 0;
+    });
+    ASSERT_GT(peer, 0);
+
+    ASSERT_EQ(pushed.wait_for(kTimeout), std::future_status::ready);
+    EXPECT_EQ(queue->size(), 1u);
+    EXPECT_TRUE(exitedCleanly(waitChild(peer)));
+}
+
+TEST(SharedMemoryEventQueueTest, OpenAttachesToANamedSegment) {
+    const std::string name = "/assessment-shmq-test-" + std::to_string(getpid());
+    auto owner = SharedMemoryEventQueue::create(name, 8, 32);
+    EXPECT_THROW(SharedMemoryEventQueue::create(name, 8, 32), std::system_error);
+
+    auto peer = SharedMemoryEventQueue::open(name);
+    EXPECT_EQ(peer->capacity(), 8u);
+    EXPECT_EQ(peer->payloadCapacity(), 32u);
+
+    owner->enqueue(makeEvent(7, "hello"));
+    auto event = peer->waitDequeue(kTimeout);
+    ASSERT_TRUE(event.has_value());
+    EXPECT_EQ(event->getId(), 7u);
+    EXPECT_EQ(event->getPayload(), "hello");
+}
+
+TEST(SharedMemoryEventQueueTest, OpenRejectsIncompatibleSegments) {
+    const std::string name = "/assessment-shmq-test-" + std::to_string(getpid());
+    EXPECT_THROW(SharedMemoryEventQueue::open(name), std::system_error);
+
+    const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(ftruncate(fd, 4096), 0);
+    const std::vector<unsigned char> garbage(4096, 0xAB);
+    ASSERT_EQ(write(fd, garbage.data(), garbage.size()), static_cast<ssize_t>(garbage.size()));
+
+    EXPECT_THROW(SharedMemoryEventQueue::open(name), std::runtime_error);
+    EXPECT_THROW(SharedMemoryEventQueue::openFd(fd), std::runtime_error);
+
+    // Too small to even hold the segment header
+    ASSERT_EQ(ftruncate(fd, 8), 0);
+    EXPECT_THROW(SharedMemoryEventQueue::openFd(fd), std::runtime_error);
+
+    close(fd);
+    shm_unlink(name.c_str());
+}
+
+TEST(SharedMemoryEventQueueTest, RecoversSlotClaimedByDeadProducer) {
+    constexpr size_t kLargePayload = 256 * 1024;
+    auto queue = SharedMemoryEventQueue::createAnonymous(4, kLargePayload);
+    queue->enqueue(makeEvent(0));
+
+    // The child claims a slot, then faults while copying the payload into it
+    const pid_t producer = forkChild([&] {
+        const rlimit noCore{0, 0};
+        setrlimit(RLIMIT_CORE, &noCore);
+        Event event = makeEvent(1, std::string(kLargePayload - 4096, 'x'));
+        const auto pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+        const auto data = reinterpret_cast<uintptr_t>(event.getPayload().data());
+        const uintptr_t page = (data + pageSize - 1) & ~(pageSize - 1);
+        mprotect(reinterpret_cast<void*>(page), pageSize, PROT_NONE);
+        queue->enqueue(event);
+        return 1;
+    });
+    ASSERT_GT(producer, 0);
+    const int status = waitChild(producer);
+    ASSERT_TRUE(WIFSIGNALED(status));
+    EXPECT_EQ(WTERMSIG(status), SIGSEGV);
+
+    queue->enqueue(makeEvent(2));
+    for (uint64_t id : {0u, 2u}) {
+        auto event = queue->waitDequeue(kTimeout);
+        ASSERT_TRUE(event.has_value()) << "event " << id << " stuck behind the dead producer's slot";
+        EXPECT_EQ(event->getId(), id);
+    }
+    EXPECT_EQ(queue->recoveredSlotCount(), 1u);
+    EXPECT_TRUE(queue->empty());
+}
+
+TEST(SharedMemoryEventQueueTest, RecoversSlotHeldByDeadConsumer) {
+    auto queue = SharedMemoryEventQueue::createAnonymous(2, 64);
+    queue->enqueue(makeEvent(0));
+    queue->enqueue(makeEvent(1));
+
+    // The child claims the head slot and dies while building the event from it
+    const pid_t consumer = forkChild([&] {
+        Event event = makeEvent(99);
+        queue->setClaimedSlotHook([] { raise(SIGKILL); });
+        queue->tryDequeue(event);
+        return 1;
+    });
+    ASSERT_GT(consumer, 0);
+    const int status = waitChild(consumer);
+    ASSERT_TRUE(WIFSIGNALED(status));
+    EXPECT_EQ(WTERMSIG(status), SIGKILL);
+
+    // The ring is full until a producer notices the dead consumer and frees its slot
+    ASSERT_TRUE(enqueueWithin(*queue, makeEvent(2)));
+    EXPECT_EQ(queue->recoveredSlotCount(), 1u);
+    for (uint64_t id : {1u, 2u}) {
+        auto event = queue->waitDequeue(kTimeout);
+        ASSERT_TRUE(event.has_value());
+        EXPECT_EQ(event->getId(), id);
+    }
+}
+
+TEST(SharedMemoryEventQueueTest, ReleasesSlotWhenBuildingTheEventThrows) {
+    auto queue = SharedMemoryEventQueue::createAnonymous(2, 64);
+    queue->enqueue(makeEvent(0));
+    queue->enqueue(makeEvent(1));
+
+    Event event = makeEvent(99);
+    queue->setClaimedSlotHook([] { throw std::bad_alloc(); });
+    EXPECT_THROW(queue->tryDequeue(event), std::bad_alloc);
+    queue->setClaimedSlotHook(nullptr);
+    EXPECT_EQ(queue->discardedRecordCount(), 1u);
+
+    // The failed event is lost but its slot is free again
+    ASSERT_TRUE(enqueueWithin(*queue, makeEvent(2)));
+    for (uint64_t id : {1u, 2u}) {
+        ASSERT_TRUE(queue->tryDequeue(event));
+        EXPECT_EQ(event.getId(), id);
+    }
+    EXPECT_EQ(queue->recoveredSlotCount(), 0u);
+}
+
+#endif // __linux__
@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "assessment/event/event_processor.h"
+#include "assessment/hardware/gpio_simulator.h"
+#include "assessment/realtime/realtime_profile.h"
+#include "queue/lockbased_queue_factory.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using assessment::event::Event;
+using assessment::event::Priority;
+using assessment::realtime::RealtimeProfile;
+using assessment::realtime::RealtimeReport;
+using assessment::realtime::SchedulingPolicy;
+
+namespace {
+
+constexpr Priority kPriorities[] = {Priority::LOW, Priority::MEDIUM, Priority::HIGH, Priority::CRITICAL};
+
+bool mentions(const RealtimeReport& report, const std::string& text) {
+    for (const auto& issue : report.issues) {
+        if (issue.find(text) != std::string::npos) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#ifdef __linux__
+// Apply `profile` on a fresh thread with a `stackSize`-byte stack
+RealtimeReport applyOnThreadWithStack(const RealtimeProfile& profile, size_t stackSize) {
+    struct Call {
+        RealtimeProfile profile;
+        RealtimeReport report;
+    } call{profile, {}};
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, stackSize);
+    pthread_t thread;
+    const int error = pthread_create(&thread, &attr, [](void* arg) -> void* {
+        auto* call = static_cast<Call*>(arg);
+        call->report = assessment::realtime::applyToCurrentThread(call->profile);
+        return nullptr;
+    }, &call);
+    pthread_attr_destroy(&attr);
+    if (error != 0) {
+        throw std::runtime_error("pthread_create failed");
+    }
+    pthread_join(thread, nullptr);
+    return call.report;
+}
+#endif
+
+} // namespace
+
+TEST(RealtimeProfileTest, NativePriorityIsInRangeAndMonotonic) {
+    for (SchedulingPolicy policy :
+         {SchedulingPolicy::DEFAULT, SchedulingPolicy::FIFO, SchedulingPolicy::ROUND_ROBIN}) {
+        int previous = -1;
+        for (Priority priority : kPriorities) {
+            const int native = assessment::realtime::toNativePriority(policy, priority);
+            if (policy == SchedulingPolicy::DEFAULT) {
+                EXPECT_EQ(native, 0);
+                continue;
+            }
+#ifdef __linux__
+            const int os = policy == SchedulingPolicy::FIFO ? SCHED_FIFO : SCHED_RR;
+            EXPECT_GE(native, sched_get_priority_min(os));
+            EXPECT_LE(native, sched_get_priority_max(os));
+#endif
+            EXPECT_GT(native, previous) << "priority " << static_cast<int>(priority);
+            previous = native;
+        }
+    }
+}
+
+TEST(RealtimeProfileTest, DefaultProfileAppliesNothing) {
+    const RealtimeReport report = assessment::realtime::applyToCurrentThread(RealtimeProfile{});
+    EXPECT_FALSE(report.affinityApplied);
+    EXPECT_FALSE(report.schedulingApplied);
+    EXPECT_FALSE(report.memoryLocked);
+    EXPECT_EQ(report.stackPrefaulted, 0u);
+    EXPECT_TRUE(report.issues.empty());
+}
+
+#ifdef __linux__
+
+TEST(RealtimeProfileTest, UnprivilegedRequestsAreReportedNotThrown) {
+    // Drop privileges in a child so the test runner keeps its own
+    const pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        const rlimit none{0, 0};
+        setrlimit(RLIMIT_RTPRIO, &none);
+        setrlimit(RLIMIT_MEMLOCK, &none);
+        if (geteuid() == 0 && (setgid(65534) != 0 || setuid(65534) != 0)) {
+            _exit(2);
+        }
+        try {
+            RealtimeProfile profile;
+            profile.policy = SchedulingPolicy::FIFO;
+            profile.priority = Priority::CRITICAL;
+            profile.lockMemory = true;
+            const RealtimeReport report = assessment::realtime::applyToCurrentThread(profile);
+            const bool reported = !report.schedulingApplied && !report.memoryLocked &&
+                mentions(report, "SCHED_FIFO") && mentions(report, "mlockall") &&
+                report.summary().find("mlockall") != std::string::npos;
+            _exit(reported ? 0 : 1);
+        } catch (...) {
+            _exit(3);
+        }
+    }
+
+    int status = 0;
+    waitpid(child, &status, 0);
+    ASSERT_TRUE(WIFEXITED(status));
+    if (WEXITSTATUS(status) == 2) {
+        GTEST_SKIP() << "cannot drop privileges here";
+    }
+    EXPECT_NE(WEXITSTATUS(status), 3) << "applyToCurrentThread threw";
+    EXPECT_EQ(WEXITSTATUS(status), 0) << "missing privileges were not reported as issues";
+}
+
+TEST(RealtimeProfileTest, StackPrefaultIsClampedToHalfTheStack) {
+    constexpr size_t kStackSize = 256 * 1024;
+    RealtimeProfile profile;
+    profile.stackPrefaultBytes = 4 * kStackSize;
+
+    const RealtimeReport report = applyOnThreadWithStack(profile, kStackSize);
+    EXPECT_GE(report.stackPrefaulted, kStackSize / 2);
+    EXPECT_LT(report.stackPrefaulted, kStackSize);
+    EXPECT_TRUE(mentions(report, "stack prefault clamped to " + std::to_string(kStackSize / 2)));
+}
+
+TEST(RealtimeProfileTest, StackPrefaultWithinTheStackIsNotReported) {
+    RealtimeProfile profile;
+    profile.stackPrefaultBytes = 32 * 1024;
+
+    const RealtimeReport report = applyOnThreadWithStack(profile, 1024 * 1024);
+    EXPECT_GE(report.stackPrefaulted, profile.stackPrefaultBytes);
+    EXPECT_TRUE(report.issues.empty());
+}
+
+TEST(RealtimeProfileTest, ComponentsReportTheProfileAppliedAtStart) {
+    RealtimeProfile profile;
+    profile.cpu = sched_getcpu();
+    profile.stackPrefaultBytes = 16 * 1024;
+    ASSERT_GE(profile.cpu, 0);
+
+    std::shared_ptr<assessment::queue::ThreadSafeQueue<Event>> queue =
+        assessment::queue::LockBasedQueueFactory::create<Event>();
+    assessment::event::EventProcessor processor(queue, std::make_shared<assessment::memory::MemoryPool>(4096));
+    assessment::hardware::GPIOSimulator simulator(queue);
+
+    EXPECT_FALSE(processor.getRealtimeReport().affinityApplied);
+    processor.setRealtimeProfile(profile);
+    simulator.setRealtimeProfile(profile);
+    processor.start();
+    simulator.start();
+
+    for (const RealtimeReport& report : {processor.getRealtimeReport(), simulator.getRealtimeReport()}) {
+        EXPECT_TRUE(report.affinityApplied) << report.summary();
+        EXPECT_FALSE(report.schedulingApplied);
+        EXPECT_GE(report.stackPrefaulted, profile.stackPrefaultBytes);
+        EXPECT_TRUE(report.issues.empty()) << report.summary();
+    }
+
+    simulator.stop();
+    processor.stop();
+}
+
+#endif // __linux__
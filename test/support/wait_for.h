@@ -0,0 +1,27 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <thread>
+
+namespace test_support {
+
+/**
+ * @brief Poll `condition` until it holds or `timeout` passes
+ * @param condition Predicate checked every millisecond
+ * @param timeout How long to keep polling
+ * @return true if the condition held before the timeout
+ */
+inline bool waitFor(const std::function<bool()>& condition,
+                    std::chrono::milliseconds timeout = std::chrono::seconds(5)) {
+    const auto giveUp = std::chrono::steady_clock::now() + timeout;
+    while (!condition()) {
+        if (std::chrono::steady_clock::now() > giveUp) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+} // namespace test_support
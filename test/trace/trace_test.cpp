@@ -0,0 +1,350 @@
+#include <gtest/gtest.h>
+
+#include <cctype>
+#include <cstdlib>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "assessment/trace/trace.h"
+
+namespace trace = assessment::trace;
+
+namespace {
+
+// Minimal JSON reader: enough to check that the exporter emits well-formed JSON and to inspect it
+struct JsonValue {
+    enum class Kind { NUL, BOOL, NUMBER, STRING, ARRAY, OBJECT };
+
+    Kind kind = Kind::NUL;
+    bool boolean = false;
+    double number = 0.0;
+    std::string text;
+    std::vector<JsonValue> items;
+    std::vector<std::pair<std::string, JsonValue>> members;
+
+    const JsonValue* find(const std::string& key) const {
+        for (const auto& member : members) {
+            if (member.first == key) {
+                return &member.second;
+            }
+        }
+        return nullptr;
+    }
+
+    std::string stringAt(const std::string& key) const {
+        const JsonValue* value = find(key);
+        return value && value->kind == Kind::STRING ? value->text : std::string();
+    }
+};
+
+class JsonParser {
+public:
+    explicit JsonParser(std::string text) : text_(std::move(text)), pos_(0) {}
+
+    JsonValue parseDocument() {
+        JsonValue value = parseValue();
+        skipSpace();
+        if (pos_ != text_.size()) {
+            fail("trailing characters");
+        }
+        return value;
+    }
+
+private:
+    [[noreturn]] void fail(const std::string& what) const {
+        throw std::runtime_error("JSON: " + what + " at offset " + std::to_string(pos_));
+    }
+
+    void skipSpace() {
+        while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+            ++pos_;
+        }
+    }
+
+    void expect(char c) {
+        skipSpace();
+        if (pos_ >= text_.size() || text_[pos_] != c) {
+            fail(std::string("expected '") + c + "'");
+        }
+        ++pos_;
+    }
+
+    bool consume(char c) {
+        skipSpace();
+        if (pos_ < text_.size() && text_[pos_] == c) {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    bool consumeWord(const char* word) {
+        const std::string expected(word);
+        if (text_.compare(pos_, expected.size(), expected) == 0) {
+            pos_ += expected.size();
+            return true;
+        }
+        return false;
+    }
+
+    JsonValue parseValue() {
+        skipSpace();
+        if (pos_ >= text_.size()) {
+            fail("unexpected end");
+        }
+        JsonValue value;
+        const char c = text_[pos_];
+        if (c == '{') {
+            value.kind = JsonValue::Kind::OBJECT;
+            ++pos_;
+            if (!consume('}')) {
+                do {
+                    skipSpace();
+                    std::string key = parseString();
+                    expect(':');
+                    value.members.emplace_back(std::move(key), parseValue());
+                } while (consume(','));
+                expect('}');
+            }
+        } else if (c == '[') {
+            value.kind = JsonValue::Kind::ARRAY;
+            ++pos_;
+            if (!consume(']')) {
+                do {
+                    value.items.push_back(parseValue());
+                } while (consume(','));
+                expect(']');
+            }
+        } else if (c == '"') {
+            value.kind = JsonValue::Kind::STRING;
+            value.text = parseString();
+        } else if (consumeWord("true")) {
+            value.kind = JsonValue::Kind::BOOL;
+            value.boolean = true;
+        } else if (consumeWord("false")) {
+            value.kind = JsonValue::Kind::BOOL;
+        } else if (consumeWord("null")) {
+            value.kind = JsonValue::Kind::NUL;
+        } else {
+            value.kind = JsonValue::Kind::NUMBER;
+            const char* begin = text_.c_str() + pos_;
+            char* end = nullptr;
+            value.number = std::strtod(begin, &end);
+            if (end == begin) {
+                fail("invalid value");
+            }
+            pos_ += static_cast<size_t>(end - begin);
+        }
+        return value;
+    }
+
+    std::string parseString() {
+        if (pos_ >= text_.size() || text_[pos_] != '"') {
+            fail("expected string");
+        }
+        ++pos_;
+        std::string result;
+        while (pos_ < text_.size() && text_[pos_] != '"') {
+            char c = text_[pos_++];
+            if (c == '\\') {
+                if (pos_ >= text_.size()) {
+                    fail("unterminated escape");
+                }
+                c = text_[pos_++];
+                switch (c) {
+                case 'n': c = '\n'; break;
+                case 't': c = '\t'; break;
+                case '"': case '\\': case '/': break;
+                default: fail("unsupported escape");
+                }
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                fail("control character in string");
+            }
+            result += c;
+        }
+        if (pos_ >= text_.size()) {
+            fail("unterminated string");
+        }
+        ++pos_;
+        return result;
+    }
+
+    std::string text_;
+    size_t pos_;
+};
+
+JsonValue exportTrace() {
+    std::ostringstream out;
+    trace::writeChromeTrace(out);
+    return JsonParser(out.str()).parseDocument();
+}
+
+const std::vector<JsonValue>& traceEvents(const JsonValue& document) {
+    const JsonValue* events = document.find("traceEvents");
+    if (!events || events->kind != JsonValue::Kind::ARRAY) {
+        throw std::runtime_error("traceEvents array missing");
+    }
+    return events->items;
+}
+
+// Events recorded by the thread that named itself `threadName`, in export order
+std::vector<const JsonValue*> eventsOfThread(const JsonValue& document, const std::string& threadName) {
+    double tid = -1.0;
+    for (const auto& event : traceEvents(document)) {
+        const JsonValue* args = event.find("args");
+        if (event.stringAt("ph") == "M" && args && args->stringAt("name") == threadName) {
+            tid = event.find("tid")->number;
+        }
+    }
+    std::vector<const JsonValue*> events;
+    for (const auto& event : traceEvents(document)) {
+        if (event.stringAt("ph") != "M" && event.find("tid") && event.find("tid")->number == tid) {
+            events.push_back(&event);
+        }
+    }
+    return events;
+}
+
+bool hasThreadName(const JsonValue& document, const std::string& threadName) {
+    for (const auto& event : traceEvents(document)) {
+        const JsonValue* args = event.find("args");
+        if (event.stringAt("ph") == "M" && args && args->stringAt("name") == threadName) {
+            return true;
+        }
+    }
+    return false;
+}
+
+class TraceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        trace::clear();
+        trace::setEnabled(true);
+    }
+
+    void TearDown() override {
+        trace::setEnabled(false);
+        trace::clear();
+    }
+};
+
+} // namespace
+
+TEST_F(TraceTest, ExportsWellFormedChromeTraceJson) {
+    std::thread worker([] {
+        trace::setThreadName("worker \"one\"");
+        {
+            trace::ScopedTrace scope("scope");
+            trace::record(trace::RecordKind::INSTANT, "instant");
+        }
+        trace::record(trace::RecordKind::COUNTER, "depth", 42);
+    });
+    worker.join();
+
+    const JsonValue document = exportTrace();
+    ASSERT_EQ(document.kind, JsonValue::Kind::OBJECT);
+    EXPECT_EQ(document.stringAt("displayTimeUnit"), "ns");
+
+    const auto events = eventsOfThread(document, "worker \"one\"");
+    ASSERT_EQ(events.size(), 4u);
+    EXPECT_EQ(events[0]->stringAt("ph"), "B");
+    EXPECT_EQ(events[0]->stringAt("name"), "scope");
+    EXPECT_EQ(events[1]->stringAt("ph"), "i");
+    EXPECT_EQ(events[1]->stringAt("s"), "t");
+    EXPECT_EQ(events[2]->stringAt("ph"), "E");
+    EXPECT_EQ(events[2]->stringAt("name"), "scope");
+    EXPECT_EQ(events[3]->stringAt("ph"), "C");
+    ASSERT_NE(events[3]->find("args"), nullptr);
+    EXPECT_EQ(events[3]->find("args")->find("value")->number, 42.0);
+
+    for (size_t i = 1; i < events.size(); ++i) {
+        EXPECT_LE(events[i - 1]->find("ts")->number, events[i]->find("ts")->number);
+    }
+}
+
+TEST_F(TraceTest, DisabledTracingRecordsNothing) {
+    trace::setEnabled(false);
+    std::thread worker([] {
+        trace::setThreadName("idle");
+        trace::ScopedTrace scope("ignored");
+    });
+    worker.join();
+
+    const JsonValue document = exportTrace();
+    EXPECT_TRUE(eventsOfThread(document, "idle").empty());
+}
+
+TEST_F(TraceTest, NamingAThreadWhileDisabledAllocatesNoBuffer) {
+    trace::setEnabled(false);
+    std::thread worker([] { trace::setThreadName("unbuffered"); });
+    worker.join();
+
+    // A registered thread always exports its name, even with no records
+    EXPECT_FALSE(hasThreadName(exportTrace(), "unbuffered"));
+}
+
+TEST_F(TraceTest, FirstRecordAfterEnablingUsesTheNameSetWhileDisabled) {
+    trace::setEnabled(false);
+    std::thread worker([] {
+        trace::setThreadName("late");
+        trace::setEnabled(true);
+        trace::record(trace::RecordKind::INSTANT, "first");
+    });
+    worker.join();
+
+    const JsonValue document = exportTrace();
+    const auto events = eventsOfThread(document, "late");
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0]->stringAt("name"), "first");
+}
+
+TEST_F(TraceTest, RegistrationReleasesExitedThreadsThatRecordedNothing) {
+    std::thread busy([] {
+        trace::setThreadName("busy");
+        trace::record(trace::RecordKind::INSTANT, "work");
+    });
+    busy.join();
+    std::thread silent([] { trace::setThreadName("silent"); });
+    silent.join();
+    EXPECT_TRUE(hasThreadName(exportTrace(), "silent"));
+
+    std::thread next([] { trace::setThreadName("next"); });
+    next.join();
+
+    const JsonValue document = exportTrace();
+    EXPECT_FALSE(hasThreadName(document, "silent"));
+    EXPECT_TRUE(hasThreadName(document, "busy"));
+    EXPECT_EQ(eventsOfThread(document, "busy").size(), 1u);
+}
+
+TEST_F(TraceTest, WrappedRingDropsEndsWhoseBeginWasOverwritten) {
+    std::thread worker([] {
+        trace::setThreadName("wrapped");
+        trace::record(trace::RecordKind::BEGIN, "lost");
+        for (size_t i = 0; i < trace::RECORDS_PER_THREAD; ++i) {
+            trace::record(trace::RecordKind::INSTANT, "filler");
+        }
+        trace::record(trace::RecordKind::END, "lost");
+        trace::ScopedTrace kept("kept");
+    });
+    worker.join();
+
+    const JsonValue document = exportTrace();
+    const auto events = eventsOfThread(document, "wrapped");
+    size_t begins = 0;
+    size_t ends = 0;
+    for (const JsonValue* event : events) {
+        EXPECT_NE(event->stringAt("name"), "lost");
+        begins += event->stringAt("ph") == "B";
+        ends += event->stringAt("ph") == "E";
+    }
+    EXPECT_EQ(begins, 1u);
+    EXPECT_EQ(ends, 1u);
+    // The ring holds RECORDS_PER_THREAD records; the unmatched end is the only one dropped
+    EXPECT_EQ(events.size(), trace::RECORDS_PER_THREAD - 1);
+}